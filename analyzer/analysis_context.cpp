@@ -0,0 +1,134 @@
+#include <config.h>
+
+#include <analyzer/analysis_context.hpp>
+#include <util/pdbg.hpp>
+#include <util/trace.hpp>
+
+namespace fs = std::filesystem;
+
+namespace analyzer
+{
+
+// Forward references for externally defined functions.
+
+/**
+ * @brief Initializes the isolator for the chip types of the given chips.
+ * @param i_chips      The list of active chips.
+ * @param io_initTypes The chip types that have already been initialized. Any
+ *                     chip types initialized by this function will be added.
+ */
+void initializeIsolator(const std::vector<libhei::Chip>& i_chips,
+                        std::set<libhei::ChipType_t>& io_initTypes);
+
+//------------------------------------------------------------------------------
+
+/**
+ * @param  i_path Any file or directory path.
+ * @return The last write time of the path, or -1 if it could not be read.
+ */
+int64_t __getWriteTime(const std::filesystem::path& i_path);
+
+//------------------------------------------------------------------------------
+
+// The directories containing all of the data files used by the context.
+const std::vector<fs::path> __dataDirs = {
+    CHIP_DATA_DIR,
+    PACKAGE_DIR "ras-data",
+    PACKAGE_DIR "schema",
+};
+
+/**
+ * @brief Gets the last write time of each of the data directories.
+ *
+ * The data files are installed by package updates, which add, remove, or
+ * replace files. Any of those will change the write time of the directory, so
+ * there is no need to look at each file. This is the same check used by the
+ * chip data index (see initialize_isolator.cpp).
+ *
+ * @param o_dirTimes The returned map of directory paths to last write times.
+ */
+void __getDirTimes(std::map<fs::path, int64_t>& o_dirTimes)
+{
+    o_dirTimes.clear();
+
+    for (const auto& dir : __dataDirs)
+    {
+        o_dirTimes.emplace(dir, __getWriteTime(dir));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+// The active context. Access is protected by __activeMutex.
+std::shared_ptr<AnalysisContext> __activeContext;
+std::mutex __activeMutex;
+
+std::shared_ptr<AnalysisContext> AnalysisContext::getActive()
+{
+    std::scoped_lock lock{__activeMutex};
+    return __activeContext;
+}
+
+void AnalysisContext::setActive(std::shared_ptr<AnalysisContext> i_context)
+{
+    std::scoped_lock lock{__activeMutex};
+    __activeContext = std::move(i_context);
+}
+
+//------------------------------------------------------------------------------
+
+AnalysisContext::~AnalysisContext()
+{
+    unload();
+}
+
+//------------------------------------------------------------------------------
+
+void AnalysisContext::refresh()
+{
+    // Invalidate everything if any of the data directories have changed on
+    // disk.
+    std::map<fs::path, int64_t> dirTimes;
+    __getDirTimes(dirTimes);
+
+    if (iv_rasData && dirTimes != iv_dirTimes)
+    {
+        trace::inf("Data files changed, reloading analysis context");
+        unload();
+    }
+
+    iv_dirTimes = std::move(dirTimes);
+
+    // The list of active chips may change between analyses (i.e. chips may be
+    // deconfigured during an IPL). So always get the latest list.
+    util::pdbg::getActiveChips(iv_chips);
+
+    // Initialize the isolator with any chip types that have not already been
+    // initialized.
+    initializeIsolator(iv_chips, iv_initTypes);
+
+    // The RAS data parser will load any additional chip types on demand.
+    if (!iv_rasData)
+    {
+        iv_rasData = std::make_unique<RasDataParser>(iv_initTypes);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void AnalysisContext::unload()
+{
+    if (!iv_initTypes.empty())
+    {
+        trace::inf("Uninitializing isolator...");
+        libhei::uninitialize();
+        iv_initTypes.clear();
+    }
+
+    iv_rasData.reset();
+    iv_dirTimes.clear();
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace analyzer
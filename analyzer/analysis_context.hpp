@@ -0,0 +1,104 @@
+#pragma once
+
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <hei_main.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace analyzer
+{
+
+/**
+ * @brief The state needed to analyze hardware that is expensive to build (the
+ *        isolator chip data and the RAS data).
+ *
+ * A long running process (i.e. the attention handler daemon) can create a
+ * context and make it active with setActive(). Then, analyzeHardware() will
+ * reuse the active context instead of loading all of the data again for each
+ * analysis. If there is no active context, analyzeHardware() will build a
+ * temporary context that is discarded when analysis is complete.
+ *
+ * The context is invalidated and reloaded when any of the chip data or RAS data
+ * directories change on disk (i.e. files are added, removed, or replaced).
+ */
+class AnalysisContext
+{
+  public:
+    /** @brief Default constructor. Nothing is loaded until refresh(). */
+    AnalysisContext() = default;
+
+    /** @brief Destructor. Uninitializes the isolator, if needed. */
+    ~AnalysisContext();
+
+    AnalysisContext(const AnalysisContext&) = delete;
+    AnalysisContext& operator=(const AnalysisContext&) = delete;
+    AnalysisContext(AnalysisContext&&) = delete;
+    AnalysisContext& operator=(AnalysisContext&&) = delete;
+
+  private:
+    /** @brief Serializes access to this context. */
+    std::mutex iv_mutex;
+
+    /** @brief The list of active chips found during the last refresh. */
+    std::vector<libhei::Chip> iv_chips;
+
+    /** @brief The chip types that have been initialized in the isolator. */
+    std::set<libhei::ChipType_t> iv_initTypes;
+
+    /** @brief The RAS data parser. */
+    std::unique_ptr<RasDataParser> iv_rasData;
+
+    /** @brief The last write time of each of the data directories when this
+     *         context was loaded. */
+    std::map<std::filesystem::path, int64_t> iv_dirTimes;
+
+  public:
+    /**
+     * @brief  Locks this context for the duration of an analysis.
+     * @return A lock that must be held while using the context.
+     */
+    std::unique_lock<std::mutex> lock()
+    {
+        return std::unique_lock<std::mutex>{iv_mutex};
+    }
+
+    /**
+     * @brief Gets the current list of active chips and ensures the isolator is
+     *        initialized for all of the chip types. If any of the data files
+     *        have changed on disk since the last refresh, everything is
+     *        reloaded. The caller must hold the lock.
+     */
+    void refresh();
+
+    /** @return The list of active chips found during the last refresh. */
+    const std::vector<libhei::Chip>& getChips() const
+    {
+        return iv_chips;
+    }
+
+    /** @return The RAS data parser. Only valid after refresh(). */
+    RasDataParser& getRasData()
+    {
+        return *iv_rasData;
+    }
+
+    /** @return The active context, nullptr if there is no active context. */
+    static std::shared_ptr<AnalysisContext> getActive();
+
+    /**
+     * @brief Sets the active context.
+     * @param i_context The new active context, nullptr to clear.
+     */
+    static void setActive(std::shared_ptr<AnalysisContext> i_context);
+
+  private:
+    /** @brief Uninitializes the isolator and drops the RAS data. */
+    void unload();
+};
+
+} // namespace analyzer
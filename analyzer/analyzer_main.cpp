@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <unistd.h>
 
+#include <analyzer/analysis_context.hpp>
 #include <analyzer/analyzer_main.hpp>
 #include <analyzer/ras-data/ras-data-parser.hpp>
 #include <analyzer/service_data.hpp>
@@ -9,18 +10,14 @@
 #include <util/pdbg.hpp>
 #include <util/trace.hpp>
 
+#include <chrono>
+
 namespace analyzer
 {
 //------------------------------------------------------------------------------
 
 // Forward references for externally defined functions.
 
-/**
- * @brief Will get the list of active chip and initialize the isolator.
- * @param o_chips The returned list of active chips.
- */
-void initializeIsolator(std::vector<libhei::Chip>& o_chips);
-
 /**
  * @brief  Will get the list of active chip and initialize the isolator.
  * @param  i_type      The type of analysis to perform. See enum for details.
@@ -107,15 +104,49 @@ uint32_t analyzeHardware(AnalysisType i_type, attn::DumpParameters& o_dump)
 
     trace::inf(">>> enter analyzeHardware(%s)", __analysisType(i_type));
 
+    // Use the persistent analysis context, if one is active (i.e. from the
+    // attention handler daemon). Otherwise, build a temporary context that will
+    // be discarded, and the isolator uninitialized, when analysis is complete.
+    auto context = AnalysisContext::getActive();
+    if (nullptr == context)
+    {
+        context = std::make_shared<AnalysisContext>();
+    }
+
+    // Only one analysis can use the context at a time.
+    auto lock = context->lock();
+
+    // Any SCOM/CFAM register read more than once during this analysis (i.e.
+    // by the isolator and then by plugins or FFDC collection) is only read
+    // from hardware once.
+    util::pdbg::ScopedRegisterCache hwCache{};
+
     // Initialize the isolator and get all of the chips to be analyzed.
     trace::inf("Initializing the isolator...");
-    std::vector<libhei::Chip> chips;
-    initializeIsolator(chips);
+    context->refresh();
+    const auto& chips = context->getChips();
 
-    // Isolate attentions.
+    // Isolate attentions. All registers are read serially. libpdbg is not
+    // thread safe, and the secondary processors are reached through the FSI
+    // hub of the primary processor, so the processors cannot be read
+    // concurrently.
     trace::inf("Isolating errors: # of chips=%u", chips.size());
-    libhei::IsolationData isoData{};
-    libhei::isolate(chips, isoData);
+    auto isoStart = std::chrono::steady_clock::now();
+
+    // The isolation data is built in place in a shared snapshot. It is never
+    // modified after isolation and is shared, not copied, by the filters, the
+    // service data, the plugins, and the PEL FFDC.
+    auto isoResult = std::make_shared<libhei::IsolationData>();
+    libhei::isolate(chips, *isoResult);
+
+    const IsolationDataPtr isoSnapshot{std::move(isoResult)};
+    const auto& isoData = *isoSnapshot;
+
+    trace::inf("Isolation complete: %lld us",
+               static_cast<long long>(
+                   std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - isoStart)
+                       .count()));
 
     // For debug, trace out the original list of signatures before filtering.
     for (const auto& sig : isoData.getSignatureList())
@@ -127,7 +158,7 @@ uint32_t analyzeHardware(AnalysisType i_type, attn::DumpParameters& o_dump)
 
     // Filter for root cause attention.
     libhei::Signature rootCause{};
-    RasDataParser rasData{};
+    RasDataParser& rasData = context->getRasData();
     bool attnFound = false;
     try
     {
@@ -161,7 +192,7 @@ uint32_t analyzeHardware(AnalysisType i_type, attn::DumpParameters& o_dump)
         }
 
         // Start building the service data.
-        ServiceData servData{rootCause, i_type, isoData};
+        ServiceData servData{rootCause, i_type, isoSnapshot};
 
         // Apply any service actions, if needed. Note that there are no
         // resolutions for manual analysis.
@@ -223,9 +254,7 @@ uint32_t analyzeHardware(AnalysisType i_type, attn::DumpParameters& o_dump)
         trace::inf("No active attentions found");
     }
 
-    // All done, clean up the isolator.
-    trace::inf("Uninitializing isolator...");
-    libhei::uninitialize();
+    hwCache.traceCounters();
 
     trace::inf("<<< exit analyzeHardware()");
 
@@ -13,7 +13,6 @@
 #include <xyz/openbmc_project/Logging/Create/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
-#include <fstream>
 #include <memory>
 
 namespace LogSvr = sdbusplus::xyz::openbmc_project::Logging::server;
@@ -97,9 +96,10 @@ void __addCalloutList(const ServiceData& i_servData,
     io_userDataFiles.emplace_back(util::FFDCFormat::JSON, FFDC_CALLOUTS,
                                   FFDC_VERSION1);
 
-    // Use a file stream to write the JSON to file.
-    std::ofstream o{io_userDataFiles.back().getPath()};
-    o << i_servData.getCalloutList();
+    // Use the file stream to write the JSON to file.
+    auto& file = io_userDataFiles.back();
+    file.getStream() << i_servData.getCalloutList();
+    file.seal();
 }
 
 //------------------------------------------------------------------------------
@@ -111,9 +111,10 @@ void __addCalloutFFDC(const ServiceData& i_servData,
     io_userDataFiles.emplace_back(util::FFDCFormat::Custom, FFDC_CALLOUT_FFDC,
                                   FFDC_VERSION1);
 
-    // Use a file stream to write the JSON to file.
-    std::ofstream o{io_userDataFiles.back().getPath()};
-    o << i_servData.getCalloutFFDC();
+    // Use the file stream to write the JSON to file.
+    auto& file = io_userDataFiles.back();
+    file.getStream() << i_servData.getCalloutFFDC();
+    file.seal();
 }
 
 //------------------------------------------------------------------------------
@@ -121,20 +122,22 @@ void __addCalloutFFDC(const ServiceData& i_servData,
 void __captureSignatureList(const libhei::IsolationData& i_isoData,
                             std::vector<util::FFDCFile>& io_userDataFiles)
 {
+    const auto& list = i_isoData.getSignatureList();
+
     // Create a new entry for this user data section regardless if there are any
-    // signatures in the list.
+    // signatures in the list. The size of the data is known up front, so the
+    // file is written all at once.
     io_userDataFiles.emplace_back(util::FFDCFormat::Custom, FFDC_SIGNATURES,
-                                  FFDC_VERSION1);
+                                  FFDC_VERSION1,
+                                  sizeof(uint32_t) * (1 + 3 * list.size()));
 
     // Create a streamer for easy writing to the FFDC file.
-    auto path = io_userDataFiles.back().getPath();
-    util::BinFileWriter stream{path};
+    auto& file = io_userDataFiles.back();
+    util::BinFileWriter stream{file.getStream()};
 
     // The first 4 bytes in the FFDC contains the number of signatures in the
     // list. Then, the list of signatures will follow.
 
-    auto list = i_isoData.getSignatureList();
-
     uint32_t numSigs = list.size();
     stream << numSigs;
 
@@ -146,11 +149,12 @@ void __captureSignatureList(const libhei::IsolationData& i_isoData,
         stream << word6 << word7 << word8;
     }
 
+    file.seal();
+
     // If the stream failed for any reason, remove the FFDC file.
     if (!stream.good())
     {
-        trace::err("Unable to write signature list FFDC file: %s",
-                   path.string().c_str());
+        trace::err("Unable to write signature list FFDC file");
         io_userDataFiles.pop_back();
     }
 }
@@ -166,21 +170,21 @@ void __captureRegisterDump(const libhei::IsolationData& i_isoData,
                                   FFDC_VERSION1);
 
     // Create a streamer for easy writing to the FFDC file.
-    auto path = io_userDataFiles.back().getPath();
-    util::BinFileWriter stream{path};
+    auto& file = io_userDataFiles.back();
+    util::BinFileWriter stream{file.getStream()};
 
     // The first 4 bytes in the FFDC contains the number of chips with register
     // data. Then the data for each chip will follow.
 
-    auto dump = i_isoData.getRegisterDump();
+    const auto& dump = i_isoData.getRegisterDump();
 
     uint32_t numChips = dump.size();
     stream << numChips;
 
     for (const auto& entry : dump)
     {
-        auto chip = entry.first;
-        auto regList = entry.second;
+        const auto& chip = entry.first;
+        const auto& regList = entry.second;
 
         // Each chip will have the following information:
         //   4 byte chip model/EC
@@ -222,11 +226,12 @@ void __captureRegisterDump(const libhei::IsolationData& i_isoData,
         }
     }
 
+    file.seal();
+
     // If the stream failed for any reason, remove the FFDC file.
     if (!stream.good())
     {
-        trace::err("Unable to write register dump FFDC file: %s",
-                   path.string().c_str());
+        trace::err("Unable to write register dump FFDC file");
         io_userDataFiles.pop_back();
     }
 }
@@ -267,17 +272,18 @@ void __captureHostbootScratchRegisters(
                                   FFDC_HB_SCRATCH_REGS, FFDC_VERSION1);
 
     // Create a streamer for easy writing to the FFDC file.
-    auto path = io_userDataFiles.back().getPath();
-    util::BinFileWriter stream{path};
+    auto& file = io_userDataFiles.back();
+    util::BinFileWriter stream{file.getStream()};
 
     // Add the data (CFAM addr/val, then SCOM addr/val).
     stream << cfamAddr << cfamValue << scomAddr << scomValue;
 
+    file.seal();
+
     // If the stream failed for any reason, remove the FFDC file.
     if (!stream.good())
     {
-        trace::err("Unable to write register dump FFDC file: %s",
-                   path.string().c_str());
+        trace::err("Unable to write register dump FFDC file");
         io_userDataFiles.pop_back();
     }
 }
@@ -324,16 +330,17 @@ void __captureScratchRegSignature(std::vector<util::FFDCFile>& io_userDataFiles)
                                       FFDC_SCRATCH_SIG, FFDC_VERSION1);
 
         // Create a streamer for easy writing to the FFDC file.
-        auto path = io_userDataFiles.back().getPath();
-        util::BinFileWriter stream{path};
+        auto& file = io_userDataFiles.back();
+        util::BinFileWriter stream{file.getStream()};
 
         stream << chipId << sigId;
 
+        file.seal();
+
         // If the stream failed for any reason, remove the FFDC file.
         if (!stream.good())
         {
-            trace::err("Unable to write register dump FFDC file: %s",
-                       path.string().c_str());
+            trace::err("Unable to write register dump FFDC file");
             io_userDataFiles.pop_back();
         }
     }
@@ -388,10 +395,10 @@ uint32_t commitPel(const ServiceData& i_servData)
     // and additional log data.
     std::map<std::string, std::string> logData;
 
-    // Keep track of the temporary files associated with the user data FFDC.
+    // Keep track of the in-memory files associated with the user data FFDC.
     // WARNING: Once the objects stored in this vector go out of scope, the
-    //          temporary files will be deleted. So they must remain in scope
-    //          until the PEL is submitted.
+    //          files will be closed. So they must remain in scope until the
+    //          PEL is submitted.
     std::vector<util::FFDCFile> userDataFiles;
 
     // Set the subsystem in the primary SRC.
@@ -1,13 +1,19 @@
-
 #include <assert.h>
+#include <config.h>
 
 #include <hei_main.hpp>
+#include <util/mapped_file.hpp>
 #include <util/pdbg.hpp>
 #include <util/trace.hpp>
 
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -17,112 +23,327 @@ namespace analyzer
 
 //------------------------------------------------------------------------------
 
-void __getChipDataFiles(std::map<libhei::ChipType_t, fs::path>& o_files)
+/**
+ * @brief  Reads the chip type from the header of a chip data file.
+ * @param  i_path The path to a chip data file.
+ * @return The chip type, or nullopt if this is not a valid chip data file.
+ */
+std::optional<libhei::ChipType_t> __readChipType(const fs::path& i_path)
 {
-    o_files.clear();
+    std::ifstream file{i_path, std::ios::binary};
+    if (!file.good())
+    {
+        trace::err("Unable to open file: %s", i_path.string().c_str());
+        return std::nullopt;
+    }
 
-    auto directory = "/usr/share/openpower-libhei/";
+    // The first 8-bytes is the file keyword and the next 4-bytes is the
+    // chip type.
+    libhei::FileKeyword_t keyword;
+    libhei::ChipType_t chipType;
 
-    for (const auto& entry : fs::directory_iterator(directory))
+    const size_t sz_keyword = sizeof(keyword);
+    const size_t sz_chipType = sizeof(chipType);
+    const size_t sz_buffer = sz_keyword + sz_chipType;
+
+    // Read the keyword and chip type from the file.
+    char buffer[sz_buffer];
+    file.read(buffer, sz_buffer);
+    if (!file.good())
     {
-        auto path = entry.path();
+        trace::err("Unable to read file: %s", i_path.string().c_str());
+        return std::nullopt;
+    }
 
-        std::ifstream file{path, std::ios::binary};
-        if (!file.good())
-        {
-            trace::err("Unable to open file: %s", path.string().c_str());
-            continue;
-        }
+    // Get the keyword.
+    memcpy(&keyword, &buffer[0], sz_keyword);
+    keyword = be64toh(keyword);
 
-        // The first 8-bytes is the file keyword and the next 4-bytes is the
-        // chip type.
-        libhei::FileKeyword_t keyword;
-        libhei::ChipType_t chipType;
+    // Ensure the keyword value is correct.
+    if (libhei::KW_CHIPDATA != keyword)
+    {
+        trace::err("Invalid chip data file: %s", i_path.string().c_str());
+        return std::nullopt;
+    }
 
-        const size_t sz_keyword = sizeof(keyword);
-        const size_t sz_chipType = sizeof(chipType);
-        const size_t sz_buffer = sz_keyword + sz_chipType;
+    // Get the chip type.
+    memcpy(&chipType, &buffer[sz_keyword], sz_chipType);
+    chipType = be32toh(chipType);
 
-        // Read the keyword and chip type from the file.
-        char buffer[sz_buffer];
-        file.read(buffer, sz_buffer);
-        if (!file.good())
-        {
-            trace::err("Unable to read file: %s", path.string().c_str());
-            continue;
-        }
+    return chipType;
+}
+
+//------------------------------------------------------------------------------
 
-        // Get the keyword.
-        memcpy(&keyword, &buffer[0], sz_keyword);
-        keyword = be64toh(keyword);
+/**
+ * @param  i_path Any file or directory path.
+ * @return The last write time of the path, or -1 if it could not be read.
+ */
+int64_t __getWriteTime(const fs::path& i_path)
+{
+    std::error_code ec;
+    auto time = fs::last_write_time(i_path, ec);
+    return ec ? -1 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief An index of the chip data files in a directory by chip type.
+ *
+ * Finding a chip data file would otherwise require opening every file in the
+ * directory to read its header. The index remains valid as long as the last
+ * write time of the directory is unchanged (i.e. no files were added, removed,
+ * or renamed). Each file's last write time is also recorded to detect any file
+ * modified in place.
+ */
+struct ChipDataIndex
+{
+    /** The indexed directory. */
+    fs::path dir;
 
-        // Ensure the keyword value is correct.
-        if (libhei::KW_CHIPDATA != keyword)
+    /** The last write time of the directory when the index was built. */
+    int64_t dirTime = -1;
+
+    /** The path and last write time of the chip data file for each type. */
+    std::map<libhei::ChipType_t, std::pair<fs::path, int64_t>> files;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Builds an index by reading the header of every file in a directory.
+ * @param i_dir   The chip data directory.
+ * @param o_index The returned index.
+ */
+void __scanChipDataFiles(const fs::path& i_dir, ChipDataIndex& o_index)
+{
+    o_index.dir = i_dir;
+    o_index.dirTime = __getWriteTime(i_dir);
+    o_index.files.clear();
+
+    std::error_code ec; // a missing directory simply results in an empty index
+
+    for (const auto& entry : fs::directory_iterator{i_dir, ec})
+    {
+        auto path = entry.path();
+
+        auto chipType = __readChipType(path);
+        if (!chipType)
         {
-            trace::err("Invalid chip data file: %s", path.string().c_str());
             continue;
         }
 
-        // Get the chip type.
-        memcpy(&chipType, &buffer[sz_keyword], sz_chipType);
-        chipType = be32toh(chipType);
-
         // Trace each legitimate chip data file for debug.
-        trace::inf("File found: type=0x%0" PRIx32 " path=%s", chipType,
+        trace::inf("File found: type=0x%0" PRIx32 " path=%s", *chipType,
                    path.string().c_str());
 
         // So far, so good. Add the entry.
-        auto ret = o_files.emplace(chipType, path);
+        auto ret = o_index.files.emplace(
+            *chipType, std::make_pair(path, __getWriteTime(path)));
         assert(ret.second); // Should not have duplicate entries
     }
 }
 
 //------------------------------------------------------------------------------
 
-void __initialize(const fs::path& i_path)
+/**
+ * @brief  Reads an index saved by __writeChipDataIndex().
+ * @param  i_path  The path to the index file.
+ * @param  o_index The returned index.
+ * @return True, if successful. False, if the file is missing or corrupted.
+ */
+bool __readChipDataIndex(const fs::path& i_path, ChipDataIndex& o_index)
 {
-    // Get file size.
-    const auto sz_buffer = fs::file_size(i_path);
+    // The first line contains the last write time of the directory and the
+    // directory path. Each remaining line contains the chip type (hex), the
+    // last write time, and the path of a chip data file.
+    std::ifstream file{i_path};
+
+    std::string line;
+    if (!std::getline(file, line))
+    {
+        return false;
+    }
 
-    // Create a buffer large enough to hold the entire file.
-    std::vector<char> buffer(sz_buffer);
+    std::istringstream header{line};
+    if (!(header >> o_index.dirTime >> std::ws) ||
+        !std::getline(header, line) || line.empty())
+    {
+        return false;
+    }
+    o_index.dir = line;
 
-    // Open the chip data file.
-    std::ifstream file{i_path, std::ios::binary};
-    assert(file.good()); // We've opened it once before, so it should open now.
+    o_index.files.clear();
+    while (std::getline(file, line))
+    {
+        std::istringstream entry{line};
 
-    // Read the entire file into the buffer.
-    file.read(buffer.data(), sz_buffer);
-    assert(file.good()); // Again, this should be readable.
+        libhei::ChipType_t chipType;
+        int64_t time;
+        if (!(entry >> std::hex >> chipType >> std::dec >> time >> std::ws) ||
+            !std::getline(entry, line) || line.empty())
+        {
+            return false;
+        }
 
-    // This is not necessary, but it frees up memory before calling the memory
-    // intensive initialize() function.
-    file.close();
+        o_index.files[chipType] = {line, time};
+    }
 
-    // Initialize the isolator with this chip data file.
-    libhei::initialize(buffer.data(), sz_buffer);
+    return true;
 }
 
 //------------------------------------------------------------------------------
 
-void initializeIsolator(std::vector<libhei::Chip>& o_chips)
+/**
+ * @brief Saves an index so that it can be used across restarts. Any failure is
+ *        not fatal. The index will simply be rebuilt again.
+ * @param i_path  The path to the index file.
+ * @param i_index The index to save.
+ */
+void __writeChipDataIndex(const fs::path& i_path, const ChipDataIndex& i_index)
 {
-    // Get all of the active chips to be analyzed.
-    util::pdbg::getActiveChips(o_chips);
+    std::error_code ec;
+    fs::create_directories(i_path.parent_path(), ec);
 
-    // Find all of the existing chip data files.
-    std::map<libhei::ChipType_t, fs::path> files;
-    __getChipDataFiles(files);
+    // Write a temporary file and rename it so that a partially written index
+    // file is never read.
+    auto tmpPath = fs::path{i_path}.concat(".tmp");
 
-    // Keep track of models/levels that have already been initialized.
-    std::map<libhei::ChipType_t, unsigned int> initTypes;
+    {
+        std::ofstream file{tmpPath, std::ios::trunc};
 
-    for (const auto& chip : o_chips)
+        file << i_index.dirTime << ' ' << i_index.dir.string() << '\n';
+        for (const auto& [chipType, entry] : i_index.files)
+        {
+            file << std::hex << chipType << std::dec << ' ' << entry.second
+                 << ' ' << entry.first.string() << '\n';
+        }
+
+        if (!file.good())
+        {
+            fs::remove(tmpPath, ec);
+            return;
+        }
+    }
+
+    fs::rename(tmpPath, i_path, ec);
+}
+
+//------------------------------------------------------------------------------
+
+// The chip data index for each directory, held for the life of the process.
+// Access is protected by __chipDataMutex.
+std::map<fs::path, ChipDataIndex> __chipDataIndexes;
+std::mutex __chipDataMutex;
+
+/**
+ * @brief  Finds the chip data file for a chip type using the index of the
+ *         given directory. Typically, this only requires checking the last
+ *         write time of the directory and the chip data file. The index is
+ *         loaded from the index file, if needed, and is only rebuilt when the
+ *         directory or the chip data file has changed.
+ * @param  i_chipType  The target chip type.
+ * @param  i_dir       The chip data directory.
+ * @param  i_indexPath The path to the index file for the directory.
+ * @return The path to the chip data file, or an empty path if not found.
+ */
+fs::path __findChipDataFile(libhei::ChipType_t i_chipType,
+                            const fs::path& i_dir, const fs::path& i_indexPath)
+{
+    std::scoped_lock lock{__chipDataMutex};
+
+    auto& index = __chipDataIndexes[i_dir];
+
+    bool rebuilt = false;
+
+    auto dirTime = __getWriteTime(i_dir);
+    if (-1 == dirTime || index.dirTime != dirTime)
+    {
+        // Try the index file before reading every chip data file.
+        if (-1 == dirTime || !__readChipDataIndex(i_indexPath, index) ||
+            index.dir != i_dir || index.dirTime != dirTime)
+        {
+            __scanChipDataFiles(i_dir, index);
+            __writeChipDataIndex(i_indexPath, index);
+            rebuilt = true;
+        }
+    }
+
+    auto itr = index.files.find(i_chipType);
+    if (index.files.end() != itr &&
+        __getWriteTime(itr->second.first) == itr->second.second)
+    {
+        return itr->second.first;
+    }
+
+    // The file was modified in place or, less likely, a file was changed to
+    // this chip type in place. Either way, the index is stale.
+    if (!rebuilt)
+    {
+        trace::inf("Chip data index is stale, rebuilding: %s",
+                   i_dir.string().c_str());
+
+        __scanChipDataFiles(i_dir, index);
+        __writeChipDataIndex(i_indexPath, index);
+
+        itr = index.files.find(i_chipType);
+        if (index.files.end() != itr)
+        {
+            return itr->second.first;
+        }
+    }
+
+    return {};
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @return The peak resident set size (VmHWM) of this process in KiB, or zero
+ *         if it could not be read.
+ */
+size_t __getPeakRss()
+{
+    std::ifstream file{"/proc/self/status"};
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.starts_with("VmHWM:"))
+        {
+            return std::stoul(line.substr(6));
+        }
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+void __initialize(const fs::path& i_path)
+{
+    // Map the chip data file instead of reading it into a buffer so that the
+    // contents are never held in memory twice. It is parsed once, in order.
+    util::MappedFile file{i_path, util::MappedFile::Access::SEQUENTIAL};
+    assert(0 < file.size());
+
+    // Initialize the isolator with this chip data file. Note that the isolator
+    // only reads from the buffer, which is required for a read-only mapping.
+    libhei::initialize(const_cast<uint8_t*>(file.data()), file.size());
+}
+
+//------------------------------------------------------------------------------
+
+void initializeIsolator(const std::vector<libhei::Chip>& i_chips,
+                        std::set<libhei::ChipType_t>& io_initTypes)
+{
+    for (const auto& chip : i_chips)
     {
         auto chipType = chip.getType();
 
         // Mark this chip type as initialized (or will be if it hasn't been).
-        auto ret = initTypes.emplace(chipType, 1);
+        auto ret = io_initTypes.emplace(chipType);
         if (!ret.second)
         {
             // This type has already been initialized. Nothing more to do.
@@ -130,13 +351,19 @@ void initializeIsolator(std::vector<libhei::Chip>& o_chips)
         }
 
         // Get the file for this chip.
-        auto itr = files.find(chipType);
+        auto path = __findChipDataFile(chipType, CHIP_DATA_DIR,
+                                       PACKAGE_STATE_DIR "chip-data-index");
 
         // Ensure a chip data file exist for this chip.
-        assert(files.end() != itr);
+        assert(!path.empty());
 
         // Initialize this chip type.
-        __initialize(itr->second);
+        auto peakRss = __getPeakRss();
+        __initialize(path);
+
+        trace::inf("Isolator initialized: type=0x%0" PRIx32
+                   " peak RSS before=%zu KiB after=%zu KiB",
+                   chipType, peakRss, __getPeakRss());
     }
 }
 
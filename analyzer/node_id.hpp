@@ -0,0 +1,58 @@
+#pragma once
+
+#include <hei_types.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace analyzer
+{
+
+/**
+ * @brief  Returns the node ID for the given node name. This is the same hash as
+ *         libhei::hash<libhei::NodeId_t>(), except it can be evaluated at
+ *         compile time. Prefer the `_node` literal below for any node name
+ *         known at compile time.
+ * @param  i_name A node name (e.g. "TP_LOCAL_FIR").
+ * @return The node ID.
+ */
+constexpr libhei::NodeId_t nodeId(std::string_view i_name)
+{
+    // See libhei::hash() for details. The hash is a sum of sums of each chunk
+    // of the string, where each chunk is the size of the node ID.
+    constexpr size_t bytes = sizeof(libhei::NodeId_t);
+
+    uint64_t sumA = 0;
+    uint64_t sumB = 0;
+
+    for (size_t i = 0; i < i_name.size(); i += bytes)
+    {
+        // Pad the last chunk with null characters, if needed.
+        uint64_t chunk = 0;
+        for (size_t j = 0; j < bytes; j++)
+        {
+            chunk <<= 8;
+            chunk |= (i + j < i_name.size()) ? i_name[i + j] : '\0';
+        }
+
+        sumA += chunk;
+        sumB += sumA;
+    }
+
+    // Mask off everything except the size of the node ID.
+    sumB &= std::numeric_limits<uint64_t>::max() >> ((8 - bytes) * 8);
+
+    return static_cast<libhei::NodeId_t>(sumB);
+}
+
+/**
+ * @brief  A node ID literal (e.g. "TP_LOCAL_FIR"_node). The node ID is always
+ *         computed at compile time.
+ */
+consteval libhei::NodeId_t operator""_node(const char* i_str, size_t i_len)
+{
+    return nodeId({i_str, i_len});
+}
+
+} // namespace analyzer
@@ -1,6 +1,6 @@
 
+#include <analyzer/node_id.hpp>
 #include <analyzer/plugins/plugin.hpp>
-#include <hei_util.hpp>
 #include <util/pdbg.hpp>
 #include <util/trace.hpp>
 
@@ -25,9 +25,9 @@ void pll_unlock(unsigned int, const libhei::Chip& i_ocmbChip,
 {
     using namespace util::pdbg;
 
-    auto nodeId = libhei::hash<libhei::NodeId_t>("PLL_UNLOCK");
+    constexpr auto nodeId = "PLL_UNLOCK"_node;
 
-    auto sigList = io_servData.getIsolationData().getSignatureList();
+    const auto& sigList = io_servData.getIsolationData().getSignatureList();
 
     // The PLL list is initially the same size of the signature list.
     std::vector<libhei::Signature> pllList{sigList.size()};
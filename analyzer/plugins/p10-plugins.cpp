@@ -1,6 +1,6 @@
 
+#include <analyzer/node_id.hpp>
 #include <analyzer/plugins/plugin.hpp>
-#include <hei_util.hpp>
 #include <util/pdbg.hpp>
 #include <util/trace.hpp>
 
@@ -22,9 +22,9 @@ namespace P10
 void pll_unlock(unsigned int i_instance, const libhei::Chip&,
                 ServiceData& io_servData)
 {
-    auto nodeId = libhei::hash<libhei::NodeId_t>("PLL_UNLOCK");
+    constexpr auto nodeId = "PLL_UNLOCK"_node;
 
-    auto sigList = io_servData.getIsolationData().getSignatureList();
+    const auto& sigList = io_servData.getIsolationData().getSignatureList();
 
     // The PLL list is initially the same size of the signature list.
     std::vector<libhei::Signature> pllList{sigList.size()};
@@ -184,10 +184,10 @@ void channel_timeout(unsigned int i_instance, const libhei::Chip& i_chip,
         io_servData.calloutBus(omiTarget, callout::BusType::OMI_BUS,
                                callout::Priority::LOW, false);
 
-        auto sigs = io_servData.getIsolationData().getSignatureList();
+        const auto& sigs = io_servData.getIsolationData().getSignatureList();
 
         // Check if multiple channel timeout bits (MC_DSTL_FIR[22,23]) are on.
-        const auto dstlfir = libhei::hash<libhei::NodeId_t>("MC_DSTL_FIR");
+        constexpr auto dstlfir = "MC_DSTL_FIR"_node;
 
         // Check for the first channel timeout
         auto itr = std::find_if(sigs.begin(), sigs.end(), [&](const auto& t) {
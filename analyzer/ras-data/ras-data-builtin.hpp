@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace analyzer
+{
+
+/**
+ * @brief Returns the compiled RAS data images built into the program.
+ *
+ * The images are generated from the RAS data files at build time by
+ * `ras-data-compiler.py` when the `ras-data` meson option is set to `builtin`.
+ * Otherwise, the list is empty and the RAS data is loaded from the installed
+ * data files at runtime.
+ *
+ * @return A list of RAS data images (see RasDataImage). The data is valid for
+ *         the lifetime of the program.
+ */
+std::span<const std::span<const uint8_t>> getBuiltinRasData();
+
+} // namespace analyzer
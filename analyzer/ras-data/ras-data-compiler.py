@@ -0,0 +1,505 @@
+#!/usr/bin/env python3
+
+"""
+Validates a RAS data JSON file against the RAS data schema and compiles it into
+the binary RAS data image consumed by RasDataImage (see ras-data-image.hpp).
+Schema validation requires the `jsonschema` module and can be skipped with
+`--no-validate`.
+
+With `--format cpp`, all of the input files are compiled into images that are
+embedded in a generated C++ source file defining getBuiltinRasData() (see
+ras-data-builtin.hpp).
+
+The image layout (all values little-endian):
+
+    Header
+    SignatureEntry[signatures]  sorted by key (id << 16 | inst << 8 | bit)
+    FlagEntry[flags]            sorted by key (id << 8 | bit)
+    ActionEntry[actions]        sorted by name
+    ElementEntry[elements]      grouped by action, in RAS data order
+    UnitEntry[units]            sorted by name
+    BusEntry[buses]             sorted by name
+    FilterRuleEntry[rules]      sorted by rank, in RAS data order
+    char strings[strings_size]  NUL terminated, offset 0 is the empty string
+
+Any change to this layout must also bump FORMAT_VERSION here and in
+ras-data-image.hpp.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+MAGIC = 0x52415344  # "RASD"
+FORMAT_VERSION = 2
+NONE = 0xFFFFFFFF
+
+DEFAULT_ACTION = "level2_M_th1"
+
+HEADER = struct.Struct("<IHHIIIIIIIIIII")
+SIGNATURE = struct.Struct("<II")
+FLAG = struct.Struct("<II")
+ACTION = struct.Struct("<III")
+ELEMENT = struct.Struct("<BBBxII")
+UNIT = struct.Struct("<II")
+BUS = struct.Struct("<IBxxxI")
+FILTER_RULE = struct.Struct("<BBHIIIIBBBx")
+
+ELEMENT_TYPES = [
+    "action",
+    "callout_self",
+    "callout_unit",
+    "callout_connected",
+    "callout_bus",
+    "callout_clock",
+    "callout_procedure",
+    "callout_part",
+    "plugin",
+    "flag",
+]
+
+PRIORITIES = ["HIGH", "MED", "MED_A", "MED_B", "MED_C", "LOW"]
+
+CLOCKS = ["OSC_REF_CLOCK_0", "OSC_REF_CLOCK_1", "TOD_CLOCK"]
+
+PROCEDURES = ["LEVEL2", "SUE_SEEN"]
+
+PARTS = ["PNOR"]
+
+BUS_TYPES = ["SMP_BUS", "OMI_BUS"]
+
+# Filter rule node matching, must match ras_data_image::NodeMatch.
+NODE_MATCH_ANY = 0
+NODE_MATCH_EQUAL = 1
+NODE_MATCH_NOT_EQUAL = 2
+
+# The bit positions are the libhei::AttentionType_t values.
+ATTN_TYPES = {
+    "CHIP_CS": 1,
+    "UNIT_CS": 2,
+    "RECOVERABLE": 3,
+    "SP_ATTN": 4,
+    "HOST_ATTN": 5,
+}
+
+# The bit positions must match analyzer::AnalysisType.
+ANALYSIS_TYPES = ["SYSTEM_CHECKSTOP", "TERMINATE_IMMEDIATE", "MANUAL"]
+
+# Filter rule conditions, must match ras_data_image::FilterCondition.
+CONDITION_NO_OCMB_ATTNS = 1 << 0
+
+# The bit positions must match RasDataParser::RasDataFlags. The schema also
+# allows `external_checkstop`, which is not used by the analyzer, so it is
+# placed after all of the enum values.
+FLAGS = [
+    "sue_source",
+    "sue_seen",
+    "cs_possible",
+    "recovered_error",
+    "informational_only",
+    "mnfg_informational_only",
+    "mask_but_dont_clear",
+    "crc_related_err",
+    "crc_root_cause",
+    "odp_data_corrupt_side_effect",
+    "odp_data_corrupt_root_cause",
+    "attn_from_ocmb",
+    "external_checkstop",
+]
+
+
+class StringTable:
+    """Deduplicated table of NUL terminated strings."""
+
+    def __init__(self):
+        self.data = bytearray(b"\0")
+        self.offsets = {"": 0}
+
+    def add(self, s):
+        if s not in self.offsets:
+            self.offsets[s] = len(self.data)
+            self.data += s.encode("ascii") + b"\0"
+        return self.offsets[s]
+
+
+def node_id(name):
+    """Returns the node ID for the given node name. This is the same 16-bit
+    hash as libhei::hash<libhei::NodeId_t>()."""
+
+    data = name.encode("ascii")
+    sum_a = 0
+    sum_b = 0
+    for i in range(0, len(data), 2):
+        chunk = data[i : i + 2].ljust(2, b"\0")
+        sum_a += chunk[0] << 8 | chunk[1]
+        sum_b += sum_a
+    return sum_b & 0xFFFF
+
+
+def compile_filter_rules(section):
+    """Returns the filter rule entries for the given `filter_rules` section,
+    sorted by rank. A rule with multiple nodes is expanded into one entry per
+    node."""
+
+    entries = []
+    for rule in section.get("rules", []):
+        bits = 0xFFFFFFFFFFFFFFFF
+        if "bits" in rule:
+            bits = 0
+            for b in rule["bits"]:
+                bits |= 1 << b
+
+        attn_types = 0
+        for t in rule.get("attn_types", ATTN_TYPES):
+            attn_types |= 1 << ATTN_TYPES[t]
+
+        analysis_types = 0
+        for t in rule.get("analysis_types", ANALYSIS_TYPES):
+            analysis_types |= 1 << ANALYSIS_TYPES.index(t)
+
+        any_flags = 0
+        for f in rule.get("any_flags", []):
+            any_flags |= 1 << FLAGS.index(f)
+
+        no_flags = 0
+        for f in rule.get("no_flags", []):
+            no_flags |= 1 << FLAGS.index(f)
+
+        conditions = 0
+        if rule.get("no_ocmb_attns", False):
+            conditions |= CONDITION_NO_OCMB_ATTNS
+
+        if "nodes" in rule:
+            nodes = [(NODE_MATCH_EQUAL, node_id(n)) for n in rule["nodes"]]
+        elif "exclude_node" in rule:
+            nodes = [(NODE_MATCH_NOT_EQUAL, node_id(rule["exclude_node"]))]
+        else:
+            nodes = [(NODE_MATCH_ANY, 0)]
+
+        for match, node in nodes:
+            entries.append(
+                (
+                    rule["rank"],
+                    match,
+                    node,
+                    bits & 0xFFFFFFFF,
+                    bits >> 32,
+                    any_flags,
+                    no_flags,
+                    attn_types,
+                    analysis_types,
+                    conditions,
+                )
+            )
+
+    # Python's sort is stable, so rules of the same rank keep their order.
+    entries.sort(key=lambda e: e[0])
+
+    return entries
+
+
+def check_cycles(actions):
+    """Raises an exception if any action references itself, directly or
+    indirectly."""
+
+    done = set()
+
+    def visit(name, stack):
+        if name in done:
+            return
+        if name in stack:
+            cycle = " -> ".join(stack[stack.index(name) :] + [name])
+            raise ValueError("Cyclic action reference: " + cycle)
+        stack.append(name)
+        for e in actions[name]:
+            if e["type"] == "action":
+                visit(e["name"], stack)
+        stack.pop()
+        done.add(name)
+
+    for name in sorted(actions):
+        visit(name, [])
+
+
+def compile_data(data):
+    units = data.get("units", {})
+    buses = data.get("buses", {})
+    actions = data["actions"]
+
+    unit_names = sorted(units)
+    bus_names = sorted(buses)
+    action_names = sorted(actions)
+
+    unit_idx = {n: i for i, n in enumerate(unit_names)}
+    bus_idx = {n: i for i, n in enumerate(bus_names)}
+    action_idx = {n: i for i, n in enumerate(action_names)}
+
+    def lookup(table, name, what, context):
+        try:
+            return table[name]
+        except KeyError:
+            raise ValueError(
+                "Undefined %s '%s' referenced by %s" % (what, name, context)
+            )
+
+    # Verify all bus units exist.
+    for n in bus_names:
+        if "unit" in buses[n]:
+            lookup(unit_idx, buses[n]["unit"], "unit", "bus " + n)
+
+    # Verify all referenced actions exist before looking for cycles.
+    for n in action_names:
+        for e in actions[n]:
+            if e["type"] == "action":
+                lookup(action_idx, e["name"], "action", "action " + n)
+
+    check_cycles(actions)
+
+    strings = StringTable()
+
+    # Signatures and signature flags.
+    sig_entries = []
+    flag_entries = []
+    for sid, bits in data["signatures"].items():
+        for bit, insts in bits.items():
+            key = int(sid, 16) << 8 | int(bit, 16)
+            mask = 0
+            for inst, value in insts.items():
+                if inst == "flags":
+                    for f in value:
+                        mask |= 1 << FLAGS.index(f)
+                    continue
+                context = "signature %s %s %s" % (sid, bit, inst)
+                sig_entries.append(
+                    (
+                        int(sid, 16) << 16 | int(inst, 16) << 8 | int(bit, 16),
+                        lookup(action_idx, value, "action", context),
+                    )
+                )
+            if mask:
+                flag_entries.append((key, mask))
+
+    sig_entries.sort()
+    flag_entries.sort()
+
+    # Actions and their elements.
+    act_entries = []
+    elem_entries = []
+    for n in action_names:
+        first = len(elem_entries)
+        for e in actions[n]:
+            t = e["type"]
+            priority = PRIORITIES.index(e.get("priority", "HIGH"))
+            guard = 1 if e.get("guard", False) else 0
+            arg0 = 0
+            arg1 = 0
+            ctx = "action " + n
+            if t == "action":
+                arg0 = action_idx[e["name"]]
+            elif t == "callout_unit":
+                arg0 = lookup(unit_idx, e["name"], "unit", ctx)
+            elif t in ("callout_connected", "callout_bus"):
+                arg0 = lookup(bus_idx, e["name"], "bus", ctx)
+            elif t == "callout_clock":
+                arg0 = CLOCKS.index(e["name"])
+            elif t == "callout_procedure":
+                arg0 = PROCEDURES.index(e["name"])
+            elif t == "callout_part":
+                arg0 = PARTS.index(e["name"])
+            elif t == "plugin":
+                arg0 = strings.add(e["name"])
+                arg1 = e["instance"]
+            elif t == "flag":
+                arg0 = FLAGS.index(e["name"])
+            elem_entries.append(
+                (ELEMENT_TYPES.index(t), priority, guard, arg0, arg1)
+            )
+        act_entries.append(
+            (strings.add(n), first, len(elem_entries) - first)
+        )
+
+    unit_entries = [(strings.add(n), strings.add(units[n])) for n in unit_names]
+
+    bus_entries = []
+    for n in bus_names:
+        b = buses[n]
+        unit = unit_idx[b["unit"]] if "unit" in b else NONE
+        bus_entries.append((strings.add(n), BUS_TYPES.index(b["type"]), unit))
+
+    # Without the filter rules, there would be no root cause at all (not even
+    # for a manual attention). So this is not allowed to default to nothing.
+    if "filter_rules" not in data:
+        raise ValueError("Missing filter_rules section")
+
+    filter_section = data["filter_rules"]
+    filter_entries = compile_filter_rules(filter_section)
+
+    # Pad the string table so the total image size is a multiple of 4.
+    while len(strings.data) % 4:
+        strings.data += b"\0"
+
+    out = bytearray()
+    out += HEADER.pack(
+        MAGIC,
+        FORMAT_VERSION,
+        data["version"],
+        int(data["model_ec"], 16),
+        action_idx.get(DEFAULT_ACTION, NONE),
+        len(sig_entries),
+        len(flag_entries),
+        len(act_entries),
+        len(elem_entries),
+        len(unit_entries),
+        len(bus_entries),
+        filter_section["version"],
+        len(filter_entries),
+        len(strings.data),
+    )
+    for e in sig_entries:
+        out += SIGNATURE.pack(*e)
+    for e in flag_entries:
+        out += FLAG.pack(*e)
+    for e in act_entries:
+        out += ACTION.pack(*e)
+    for e in elem_entries:
+        out += ELEMENT.pack(*e)
+    for e in unit_entries:
+        out += UNIT.pack(*e)
+    for e in bus_entries:
+        out += BUS.pack(*e)
+    for e in filter_entries:
+        out += FILTER_RULE.pack(*e)
+    out += strings.data
+
+    return bytes(out)
+
+
+def compile_file(schema, path, validator):
+    """Validates (if a validator is given) and compiles the given RAS data
+    file, exits on error."""
+    with open(path) as f:
+        data = json.load(f)
+
+    try:
+        if data.get("version") != schema["version"]:
+            raise ValueError(
+                "Data version %s does not match schema version %s"
+                % (data.get("version"), schema["version"])
+            )
+        if validator:
+            validator(data)
+        return compile_data(data)
+    except ValueError as e:
+        sys.exit("%s: %s" % (path, e))
+
+
+def get_validator(schema):
+    """Returns a function that validates RAS data against the given schema and
+    raises ValueError on failure."""
+    import jsonschema
+
+    def validate(data):
+        try:
+            jsonschema.validate(instance=data, schema=schema)
+        except jsonschema.ValidationError as e:
+            raise ValueError(str(e)) from e
+
+    return validate
+
+
+def generate_cpp(paths, images):
+    """Returns C++ source defining getBuiltinRasData() for the given images."""
+    out = [
+        "// Generated by ras-data-compiler.py. Do not edit.",
+        "",
+        "#include <analyzer/ras-data/ras-data-builtin.hpp>",
+        "",
+        "namespace analyzer",
+        "{",
+        "",
+        "namespace",
+        "{",
+        "",
+    ]
+
+    for i, (path, image) in enumerate(zip(paths, images)):
+        out.append("// %s" % os.path.basename(path))
+        out.append("alignas(4) constexpr uint8_t __image%d[] = {" % i)
+        for off in range(0, len(image), 12):
+            chunk = image[off : off + 12]
+            out.append("    " + " ".join("0x%02x," % b for b in chunk))
+        out.append("};")
+        out.append("")
+
+    if images:
+        out.append("constexpr std::span<const uint8_t> __images[] = {")
+        for i in range(len(images)):
+            out.append("    __image%d," % i)
+        out.append("};")
+    else:
+        out.append(
+            "constexpr std::span<const std::span<const uint8_t>> __images{};"
+        )
+
+    out += [
+        "",
+        "} // namespace",
+        "",
+        "std::span<const std::span<const uint8_t>> getBuiltinRasData()",
+        "{",
+        "    return __images;",
+        "}",
+        "",
+        "} // namespace analyzer",
+        "",
+    ]
+
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Validate and compile RAS data JSON files."
+    )
+    parser.add_argument(
+        "-s", "--schema", required=True, help="RAS data schema file"
+    )
+    parser.add_argument("-o", "--output", required=True, help="output file")
+    parser.add_argument(
+        "-f",
+        "--format",
+        choices=["bin", "cpp"],
+        default="bin",
+        help="output a single RAS data image (bin) or C++ source containing "
+        "all of the images (cpp)",
+    )
+    parser.add_argument(
+        "--no-validate",
+        action="store_true",
+        help="skip the schema validation (does not require jsonschema)",
+    )
+    parser.add_argument("inputs", nargs="*", help="input RAS data JSON files")
+    args = parser.parse_args()
+
+    if "bin" == args.format and 1 != len(args.inputs):
+        parser.error("exactly one input file is required for bin format")
+
+    with open(args.schema) as f:
+        schema = json.load(f)
+
+    validator = None if args.no_validate else get_validator(schema)
+
+    images = [compile_file(schema, path, validator) for path in args.inputs]
+
+    if "bin" == args.format:
+        with open(args.output, "wb") as f:
+            f.write(images[0])
+    else:
+        with open(args.output, "w") as f:
+            f.write(generate_cpp(args.inputs, images))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,260 @@
+#include <analyzer/ras-data/ras-data-image.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace analyzer
+{
+
+using namespace ras_data_image;
+
+//------------------------------------------------------------------------------
+
+RasDataImage::RasDataImage(const std::filesystem::path& i_path) :
+    iv_file(std::in_place, i_path, util::MappedFile::Access::RANDOM)
+{
+    iv_data = {iv_file->data(), iv_file->size()};
+    validate();
+}
+
+//------------------------------------------------------------------------------
+
+RasDataImage::RasDataImage(std::span<const uint8_t> i_data) : iv_data(i_data)
+{
+    validate();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+std::span<const T> __getTable(std::span<const uint8_t> i_data, size_t& io_off,
+                              uint32_t i_count)
+{
+    size_t size = sizeof(T) * i_count;
+    if (i_data.size() - io_off < size)
+    {
+        throw std::runtime_error("RAS data image truncated");
+    }
+
+    auto table = reinterpret_cast<const T*>(i_data.data() + io_off);
+    io_off += size;
+
+    return {table, i_count};
+}
+
+//------------------------------------------------------------------------------
+
+void RasDataImage::validate()
+{
+    // The image is generated in little-endian format. There is no support for
+    // converting it on a big-endian host. The caller should fall back to the
+    // JSON data instead.
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        throw std::runtime_error("RAS data image requires little-endian host");
+    }
+
+    // All tables are made of 32-bit fields.
+    if (0 != reinterpret_cast<uintptr_t>(iv_data.data()) % alignof(Header))
+    {
+        throw std::runtime_error("RAS data image not aligned");
+    }
+
+    if (iv_data.size() < sizeof(Header))
+    {
+        throw std::runtime_error("RAS data image truncated");
+    }
+
+    iv_header = reinterpret_cast<const Header*>(iv_data.data());
+
+    if (MAGIC != iv_header->magic)
+    {
+        throw std::runtime_error("Invalid RAS data image magic");
+    }
+
+    if (FORMAT_VERSION != iv_header->formatVersion)
+    {
+        throw std::runtime_error("Unsupported RAS data image format: " +
+                                 std::to_string(iv_header->formatVersion));
+    }
+
+    size_t off = sizeof(Header);
+
+    iv_signatures = __getTable<SignatureEntry>(iv_data, off,
+                                               iv_header->signatures);
+    iv_flags = __getTable<FlagEntry>(iv_data, off, iv_header->flags);
+    iv_actions = __getTable<ActionEntry>(iv_data, off, iv_header->actions);
+    iv_elements = __getTable<ElementEntry>(iv_data, off, iv_header->elements);
+    iv_units = __getTable<UnitEntry>(iv_data, off, iv_header->units);
+    iv_buses = __getTable<BusEntry>(iv_data, off, iv_header->buses);
+    iv_filterRules = __getTable<FilterRuleEntry>(iv_data, off,
+                                                 iv_header->filterRules);
+    iv_strings = __getTable<char>(iv_data, off, iv_header->stringsSize);
+
+    // The string table must start with the empty string and end with a NUL
+    // character so that any offset within the table is a valid string.
+    if (iv_strings.empty() || '\0' != iv_strings.front() ||
+        '\0' != iv_strings.back())
+    {
+        throw std::runtime_error("Invalid RAS data image string table");
+    }
+
+    auto checkIndex = [](uint32_t i_index, size_t i_size) {
+        if (i_index >= i_size)
+        {
+            throw std::runtime_error("Invalid RAS data image index");
+        }
+    };
+
+    auto checkString = [&](uint32_t i_offset) {
+        checkIndex(i_offset, iv_strings.size());
+    };
+
+    if (NONE != iv_header->defaultAction)
+    {
+        checkIndex(iv_header->defaultAction, iv_actions.size());
+    }
+
+    for (const auto& s : iv_signatures)
+    {
+        checkIndex(s.action, iv_actions.size());
+    }
+
+    for (const auto& a : iv_actions)
+    {
+        checkString(a.name);
+        if (a.first > iv_elements.size() ||
+            a.count > iv_elements.size() - a.first)
+        {
+            throw std::runtime_error("Invalid RAS data image action");
+        }
+    }
+
+    for (const auto& e : iv_elements)
+    {
+        checkIndex(e.priority, 6); // number of callout::Priority values
+
+        switch (e.type)
+        {
+            case ElementType::ACTION:
+                checkIndex(e.arg0, iv_actions.size());
+                break;
+            case ElementType::CALLOUT_SELF:
+                break;
+            case ElementType::CALLOUT_UNIT:
+                checkIndex(e.arg0, iv_units.size());
+                break;
+            case ElementType::CALLOUT_CONNECTED:
+            case ElementType::CALLOUT_BUS:
+                checkIndex(e.arg0, iv_buses.size());
+                break;
+            case ElementType::CALLOUT_CLOCK:
+                checkIndex(e.arg0, 3); // number of clock types
+                break;
+            case ElementType::CALLOUT_PROCEDURE:
+                checkIndex(e.arg0, 2); // number of procedures
+                break;
+            case ElementType::CALLOUT_PART:
+                checkIndex(e.arg0, 1); // number of part types
+                break;
+            case ElementType::PLUGIN:
+                checkString(e.arg0);
+                break;
+            case ElementType::FLAG:
+                checkIndex(e.arg0, 32);
+                break;
+            default:
+                throw std::runtime_error("Invalid RAS data image element");
+        }
+    }
+
+    for (const auto& u : iv_units)
+    {
+        checkString(u.name);
+        checkString(u.path);
+    }
+
+    for (const auto& b : iv_buses)
+    {
+        checkString(b.name);
+        checkIndex(b.type, 2); // number of bus types
+        if (NONE != b.unit)
+        {
+            checkIndex(b.unit, iv_units.size());
+        }
+    }
+
+    for (const auto& r : iv_filterRules)
+    {
+        checkIndex(static_cast<uint32_t>(r.nodeMatch), 3); // NodeMatch values
+    }
+
+    // The filter rules must be sorted by rank.
+    if (!std::ranges::is_sorted(iv_filterRules, {}, &FilterRuleEntry::rank))
+    {
+        throw std::runtime_error("Invalid RAS data image filter rules");
+    }
+}
+
+//------------------------------------------------------------------------------
+
+uint32_t RasDataImage::getSignatureAction(
+    const libhei::Signature& i_signature) const
+{
+    uint32_t key = i_signature.getId() << 16 | i_signature.getInstance() << 8 |
+                   i_signature.getBit();
+
+    auto itr = std::lower_bound(
+        iv_signatures.begin(), iv_signatures.end(), key,
+        [](const SignatureEntry& a, uint32_t b) { return a.key < b; });
+
+    if (iv_signatures.end() != itr && key == itr->key)
+    {
+        return itr->action;
+    }
+
+    return NONE;
+}
+
+//------------------------------------------------------------------------------
+
+uint32_t RasDataImage::getSignatureFlags(libhei::NodeId_t i_id,
+                                         libhei::BitPosition_t i_bit) const
+{
+    uint32_t key = i_id << 8 | i_bit;
+
+    auto itr = std::lower_bound(
+        iv_flags.begin(), iv_flags.end(), key,
+        [](const FlagEntry& a, uint32_t b) { return a.key < b; });
+
+    if (iv_flags.end() != itr && key == itr->key)
+    {
+        return itr->flags;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+uint32_t RasDataImage::findAction(std::string_view i_name) const
+{
+    auto itr = std::lower_bound(
+        iv_actions.begin(), iv_actions.end(), i_name,
+        [this](const ActionEntry& a, std::string_view b) {
+            return getString(a.name) < b;
+        });
+
+    if (iv_actions.end() != itr && i_name == getString(itr->name))
+    {
+        return itr - iv_actions.begin();
+    }
+
+    return NONE;
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace analyzer
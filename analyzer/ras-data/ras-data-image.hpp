@@ -0,0 +1,324 @@
+#pragma once
+
+#include <hei_main.hpp>
+#include <util/mapped_file.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace analyzer
+{
+
+/**
+ * @brief Binary RAS data image layout.
+ *
+ * The RAS data JSON files are validated and compiled into this format at build
+ * time by `ras-data-compiler.py`. All values are little-endian. Any change to
+ * these structures must bump FORMAT_VERSION here and in the compiler.
+ */
+namespace ras_data_image
+{
+
+/** "RASD" */
+constexpr uint32_t MAGIC = 0x52415344;
+
+/** Version of the image layout (not the RAS data version). */
+constexpr uint16_t FORMAT_VERSION = 2;
+
+/** Represents an invalid table index. */
+constexpr uint32_t NONE = 0xffffffff;
+
+/** Image header, followed by each table in the order of the counts. */
+struct Header
+{
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t dataVersion;
+    uint32_t chipType;
+    uint32_t defaultAction; // index of `level2_M_th1`, NONE if not defined
+    uint32_t signatures;
+    uint32_t flags;
+    uint32_t actions;
+    uint32_t elements;
+    uint32_t units;
+    uint32_t buses;
+    uint32_t filterVersion; // version of the filter rules, 0 if not defined
+    uint32_t filterRules;
+    uint32_t stringsSize;
+};
+
+/** Sorted by key (id << 16 | instance << 8 | bit). */
+struct SignatureEntry
+{
+    uint32_t key;
+    uint32_t action; // action index
+};
+
+/** Sorted by key (id << 8 | bit). */
+struct FlagEntry
+{
+    uint32_t key;
+    uint32_t flags; // bit mask of RasDataParser::RasDataFlags
+};
+
+/** Sorted by name. */
+struct ActionEntry
+{
+    uint32_t name;  // string offset
+    uint32_t first; // index of the first element
+    uint32_t count; // number of elements
+};
+
+enum class ElementType : uint8_t
+{
+    ACTION,            // arg0: action index
+    CALLOUT_SELF,      //
+    CALLOUT_UNIT,      // arg0: unit index
+    CALLOUT_CONNECTED, // arg0: bus index
+    CALLOUT_BUS,       // arg0: bus index
+    CALLOUT_CLOCK,     // arg0: ClockType (in compiler order)
+    CALLOUT_PROCEDURE, // arg0: Procedure (in compiler order)
+    CALLOUT_PART,      // arg0: PartType (in compiler order)
+    PLUGIN,            // arg0: name string offset, arg1: instance
+    FLAG,              // arg0: flag bit position
+};
+
+struct ElementEntry
+{
+    ElementType type;
+    uint8_t priority; // callout::Priority
+    uint8_t guard;
+    uint8_t reserved;
+    uint32_t arg0;
+    uint32_t arg1;
+};
+
+/** Sorted by name. */
+struct UnitEntry
+{
+    uint32_t name; // string offset
+    uint32_t path; // string offset
+};
+
+/** Sorted by name. */
+struct BusEntry
+{
+    uint32_t name; // string offset
+    uint8_t type;  // BusType (in compiler order)
+    uint8_t reserved[3];
+    uint32_t unit; // unit index, NONE if not defined
+};
+
+/** How the node ID of a signature is matched by a filter rule. */
+enum class NodeMatch : uint8_t
+{
+    ANY,       // any node
+    EQUAL,     // only the rule's node
+    NOT_EQUAL, // any node except the rule's node
+};
+
+/** Filter rule conditions on the entire signature list. */
+enum FilterCondition : uint8_t
+{
+    NO_OCMB_ATTNS = 1 << 0, // no signatures in the list are from an OCMB
+};
+
+/** Sorted by rank, lowest first. Rules with the same rank are in RAS data
+ *  order. */
+struct FilterRuleEntry
+{
+    uint8_t rank;
+    NodeMatch nodeMatch;
+    uint16_t node;         // node ID
+    uint32_t bits[2];      // bit mask of bit positions 0-31 and 32-63
+    uint32_t anyFlags;     // bit mask of RasDataParser::RasDataFlags
+    uint32_t noFlags;      // bit mask of RasDataParser::RasDataFlags
+    uint8_t attnTypes;     // bit mask of libhei::AttentionType_t
+    uint8_t analysisTypes; // bit mask of AnalysisType (in compiler order)
+    uint8_t conditions;    // bit mask of FilterCondition
+    uint8_t reserved;
+};
+
+static_assert(sizeof(Header) == 52);
+static_assert(sizeof(SignatureEntry) == 8);
+static_assert(sizeof(FlagEntry) == 8);
+static_assert(sizeof(ActionEntry) == 12);
+static_assert(sizeof(ElementEntry) == 12);
+static_assert(sizeof(UnitEntry) == 8);
+static_assert(sizeof(BusEntry) == 12);
+static_assert(sizeof(FilterRuleEntry) == 24);
+
+} // namespace ras_data_image
+
+/**
+ * @brief A read-only view of a compiled RAS data image.
+ *
+ * The image is validated when the object is constructed so that none of the
+ * accessors need to do any bounds checking. All lookups are binary searches on
+ * the sorted tables and no memory is allocated after construction.
+ */
+class RasDataImage
+{
+  public:
+    /**
+     * @brief Maps the given image file into memory and validates it.
+     * @param i_path The path to the image file.
+     * @throw std::runtime_error if the file can't be mapped or is invalid.
+     */
+    explicit RasDataImage(const std::filesystem::path& i_path);
+
+    /**
+     * @brief Validates an image already in memory. The caller must ensure the
+     *        data outlives this object.
+     * @param i_data The image contents.
+     * @throw std::runtime_error if the image is invalid.
+     */
+    explicit RasDataImage(std::span<const uint8_t> i_data);
+
+    RasDataImage(const RasDataImage&) = delete;
+    RasDataImage& operator=(const RasDataImage&) = delete;
+    RasDataImage(RasDataImage&&) = default;
+    RasDataImage& operator=(RasDataImage&&) = default;
+    ~RasDataImage() = default;
+
+  private:
+    /** @brief The mapped image file, if the image was loaded from a file. */
+    std::optional<util::MappedFile> iv_file;
+
+    /** @brief The image contents. */
+    std::span<const uint8_t> iv_data;
+
+    /** Pointers to each of the tables in the image. */
+    const ras_data_image::Header* iv_header = nullptr;
+    std::span<const ras_data_image::SignatureEntry> iv_signatures;
+    std::span<const ras_data_image::FlagEntry> iv_flags;
+    std::span<const ras_data_image::ActionEntry> iv_actions;
+    std::span<const ras_data_image::ElementEntry> iv_elements;
+    std::span<const ras_data_image::UnitEntry> iv_units;
+    std::span<const ras_data_image::BusEntry> iv_buses;
+    std::span<const ras_data_image::FilterRuleEntry> iv_filterRules;
+    std::span<const char> iv_strings;
+
+  public:
+    /** @return The chip type associated with this RAS data. */
+    libhei::ChipType_t getChipType() const
+    {
+        return iv_header->chipType;
+    }
+
+    /** @return The version of the RAS data file this image was built from. */
+    unsigned int getVersion() const
+    {
+        return iv_header->dataVersion;
+    }
+
+    /**
+     * @param  i_signature The target error signature.
+     * @return The index of the action for the given signature, NONE if not
+     *         defined.
+     */
+    uint32_t getSignatureAction(const libhei::Signature& i_signature) const;
+
+    /**
+     * @return The index of the action used when a signature is not defined
+     *         (`level2_M_th1`), NONE if not defined.
+     */
+    uint32_t getDefaultAction() const
+    {
+        return iv_header->defaultAction;
+    }
+
+    /** @return The table of all signatures defined in the image. */
+    std::span<const ras_data_image::SignatureEntry> getSignatures() const
+    {
+        return iv_signatures;
+    }
+
+    /**
+     * @param  i_signature The target error signature.
+     * @return A bit mask of the flags defined for the signature's node and
+     *         bit. Flags inherited from the signature's action are not
+     *         included.
+     */
+    uint32_t getSignatureFlags(const libhei::Signature& i_signature) const
+    {
+        return getSignatureFlags(i_signature.getId(), i_signature.getBit());
+    }
+
+    /**
+     * @param  i_id  A node ID.
+     * @param  i_bit A bit position within the node.
+     * @return Same as getSignatureFlags() above.
+     */
+    uint32_t getSignatureFlags(libhei::NodeId_t i_id,
+                               libhei::BitPosition_t i_bit) const;
+
+    /** @return The number of actions in the image. */
+    uint32_t getNumActions() const
+    {
+        return iv_actions.size();
+    }
+
+    /**
+     * @param  i_name The action name.
+     * @return The index of the given action, NONE if not defined.
+     */
+    uint32_t findAction(std::string_view i_name) const;
+
+    /** @return The name of the given action. */
+    std::string_view getActionName(uint32_t i_action) const
+    {
+        return getString(iv_actions[i_action].name);
+    }
+
+    /** @return The list of elements for the given action. */
+    std::span<const ras_data_image::ElementEntry> getActionElements(
+        uint32_t i_action) const
+    {
+        const auto& a = iv_actions[i_action];
+        return iv_elements.subspan(a.first, a.count);
+    }
+
+    /** @return The name and path of the given unit. */
+    const ras_data_image::UnitEntry& getUnit(uint32_t i_unit) const
+    {
+        return iv_units[i_unit];
+    }
+
+    /** @return The given bus entry. */
+    const ras_data_image::BusEntry& getBus(uint32_t i_bus) const
+    {
+        return iv_buses[i_bus];
+    }
+
+    /** @return The version of the filter rules, 0 if not defined. */
+    unsigned int getFilterRulesVersion() const
+    {
+        return iv_header->filterVersion;
+    }
+
+    /** @return The table of all root cause filter rules, sorted by rank. */
+    std::span<const ras_data_image::FilterRuleEntry> getFilterRules() const
+    {
+        return iv_filterRules;
+    }
+
+    /** @return The string at the given offset in the string table. */
+    std::string_view getString(uint32_t i_offset) const
+    {
+        return std::string_view{iv_strings.data() + i_offset};
+    }
+
+  private:
+    /**
+     * @brief Locates the tables within the image and validates all indexes and
+     *        string offsets.
+     * @throw std::runtime_error if the image is invalid.
+     */
+    void validate();
+};
+
+} // namespace analyzer
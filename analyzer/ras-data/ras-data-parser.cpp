@@ -1,11 +1,20 @@
+#include <analyzer/analyzer_main.hpp>
+#include <analyzer/ras-data/ras-data-builtin.hpp>
 #include <analyzer/ras-data/ras-data-parser.hpp>
+#include <hei_util.hpp>
 #include <util/data_file.hpp>
+#include <util/mapped_file.hpp>
 #include <util/trace.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -14,116 +23,194 @@ namespace analyzer
 //------------------------------------------------------------------------------
 
 std::shared_ptr<Resolution> RasDataParser::getResolution(
-    const libhei::Signature& i_signature)
+    const libhei::Signature& i_signature) const
 {
-    nlohmann::json data;
+    const auto type = i_signature.getChip().getType();
 
-    try
+    std::scoped_lock lock{iv_mutex};
+
+    // Compiles all of the actions for this chip type, if needed.
+    loadDataFile(type);
+
+    auto itr = iv_signatureIndex.find(
+        getSignatureKey(type, i_signature.getId(), i_signature.getInstance(),
+                        i_signature.getBit()));
+
+    if (iv_signatureIndex.end() != itr)
     {
-        data = iv_dataFiles.at(i_signature.getChip().getType());
+        return itr->second.resolution;
     }
-    catch (const std::out_of_range& e)
+
+    auto defaultItr = iv_defaultResolutions.find(type);
+    if (iv_defaultResolutions.end() == defaultItr)
     {
-        trace::err("No RAS data defined for chip type: 0x%08x",
-                   i_signature.getChip().getType());
-        throw; // caught later downstream
+        // There is no RAS data for this chip type. The exception will be
+        // caught later downstream.
+        trace::err("No RAS data defined for chip type: 0x%08x", type);
+        throw std::out_of_range("No RAS data defined for chip type");
     }
 
-    const auto action = parseSignature(data, i_signature);
+    trace::err("No action defined for signature: %04x %02x %02x",
+               i_signature.getId(), i_signature.getBit(),
+               i_signature.getInstance());
 
-    std::shared_ptr<Resolution> resolution;
-
-    try
+    // Default to 'level2_M_th1' if no signature is found.
+    if (nullptr == defaultItr->second)
     {
-        resolution = parseAction(data, action);
+        throw std::out_of_range("Default action not defined");
     }
-    catch (...)
+
+    return defaultItr->second;
+}
+
+//------------------------------------------------------------------------------
+
+using FlagBits = RasDataParser::FlagBits;
+using rdf = RasDataParser::RasDataFlags;
+
+// List of all flag strings mapping to their corresponding enums. Any flags not
+// listed here are ignored.
+// clang-format off
+const std::map<std::string, rdf> __flagMap =
+{
+    {"sue_source",                   rdf::SUE_SOURCE},
+    {"sue_seen",                     rdf::SUE_SEEN},
+    {"cs_possible",                  rdf::CS_POSSIBLE},
+    {"recovered_error",              rdf::RECOVERED_ERROR},
+    {"informational_only",           rdf::INFORMATIONAL_ONLY},
+    {"mnfg_informational_only",      rdf::MNFG_INFORMATIONAL_ONLY},
+    {"mask_but_dont_clear",          rdf::MASK_BUT_DONT_CLEAR},
+    {"crc_related_err",              rdf::CRC_RELATED_ERR},
+    {"crc_root_cause",               rdf::CRC_ROOT_CAUSE},
+    {"odp_data_corrupt_side_effect", rdf::ODP_DATA_CORRUPT_SIDE_EFFECT},
+    {"odp_data_corrupt_root_cause",  rdf::ODP_DATA_CORRUPT_ROOT_CAUSE},
+    {"attn_from_ocmb",               rdf::ATTN_FROM_OCMB},
+};
+// clang-format on
+
+/** @brief Sets the bit for the given flag string, if supported. */
+void __setFlag(FlagBits& io_flags, const std::string& i_flag)
+{
+    auto itr = __flagMap.find(i_flag);
+    if (__flagMap.end() != itr)
     {
-        trace::err("Unable to get resolution for action: %s", action.c_str());
-        throw; // caught later downstream
+        io_flags.set(itr->second);
     }
-
-    return resolution;
 }
 
 //------------------------------------------------------------------------------
 
-bool __checkActionForFlag(const std::string& i_action,
-                          const std::string& i_flag,
-                          const nlohmann::json& i_data)
+/**
+ * @brief  Returns all flags set by the given action and any actions it
+ *         references.
+ * @param  i_data   The parsed RAS data file.
+ * @param  i_action The target action.
+ * @param  io_cache The flags of each action already visited.
+ * @return The flags set by the action.
+ */
+FlagBits __getActionFlags(const nlohmann::json& i_data,
+                          const std::string& i_action,
+                          std::map<std::string, FlagBits>& io_cache)
 {
-    bool o_isFlagSet = false;
+    auto itr = io_cache.find(i_action);
+    if (io_cache.end() != itr)
+    {
+        return itr->second;
+    }
+
+    FlagBits o_flags{};
 
     // Loop through the array of actions.
     for (const auto& a : i_data.at("actions").at(i_action))
     {
         // Get the action type
-        auto type = a.at("type").get<std::string>();
+        const auto& type = a.at("type").get_ref<const std::string&>();
 
         // If the action is another action, recursively call this function
         if ("action" == type)
         {
-            auto name = a.at("name").get<std::string>();
-            o_isFlagSet = __checkActionForFlag(name, i_flag, i_data);
-            if (o_isFlagSet)
-            {
-                break;
-            }
+            const auto& name = a.at("name").get_ref<const std::string&>();
+            o_flags |= __getActionFlags(i_data, name, io_cache);
         }
-        // If the action is a flag, check if it's the one
+        // If the action is a flag, add it
         else if ("flag" == type)
         {
-            auto name = a.at("name").get<std::string>();
-            if (name == i_flag)
-            {
-                o_isFlagSet = true;
-                break;
-            }
+            const auto& name = a.at("name").get_ref<const std::string&>();
+            __setFlag(o_flags, name);
         }
     }
 
-    return o_isFlagSet;
+    io_cache.emplace(i_action, o_flags);
+
+    return o_flags;
 }
 
 //------------------------------------------------------------------------------
 
-bool RasDataParser::isFlagSet(const libhei::Signature& i_signature,
-                              const RasDataFlags i_flag) const
+/** @brief Same as above, except the action is taken from a RAS data image. */
+FlagBits __getActionFlags(const RasDataImage& i_image, uint32_t i_action,
+                          std::vector<std::optional<FlagBits>>& io_cache)
 {
-    bool o_isFlagSet = false;
-
-    // List of all flag enums mapping to their corresponding string
-    std::map<RasDataFlags, std::string> flagMap = {
-        {SUE_SOURCE, "sue_source"},
-        {SUE_SEEN, "sue_seen"},
-        {CS_POSSIBLE, "cs_possible"},
-        {RECOVERED_ERROR, "recovered_error"},
-        {INFORMATIONAL_ONLY, "informational_only"},
-        {MNFG_INFORMATIONAL_ONLY, "mnfg_informational_only"},
-        {MASK_BUT_DONT_CLEAR, "mask_but_dont_clear"},
-        {CRC_RELATED_ERR, "crc_related_err"},
-        {CRC_ROOT_CAUSE, "crc_root_cause"},
-        {ODP_DATA_CORRUPT_SIDE_EFFECT, "odp_data_corrupt_side_effect"},
-        {ODP_DATA_CORRUPT_ROOT_CAUSE, "odp_data_corrupt_root_cause"},
-        {ATTN_FROM_OCMB, "attn_from_ocmb"},
-    };
-    std::string strFlag = flagMap[i_flag];
+    using namespace ras_data_image;
 
-    // If the input flag does not exist in the map, that's a code bug.
-    assert(0 != flagMap.count(i_flag));
+    if (io_cache[i_action])
+    {
+        return *io_cache[i_action];
+    }
 
-    nlohmann::json data;
-    try
+    FlagBits o_flags{};
+
+    for (const auto& e : i_image.getActionElements(i_action))
     {
-        data = iv_dataFiles.at(i_signature.getChip().getType());
+        if (ElementType::ACTION == e.type)
+        {
+            o_flags |= __getActionFlags(i_image, e.arg0, io_cache);
+        }
+        else if (ElementType::FLAG == e.type)
+        {
+            o_flags.set(e.arg0);
+        }
     }
-    catch (const std::out_of_range& e)
+
+    io_cache[i_action] = o_flags;
+
+    return o_flags;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Returns the flags for a signature that is not defined in the RAS
+ *         data. This includes any flags defined for the signature's node and
+ *         bit and the flags of the default action (see getResolution()).
+ * @param  i_data      The RAS data for the signature's chip type.
+ * @param  i_signature The target error signature.
+ * @return The flags for the signature.
+ */
+FlagBits __getUndefinedFlags(const RasDataParser::DataView& i_data,
+                             const libhei::Signature& i_signature)
+{
+    FlagBits o_flags{};
+
+    // Use the compiled RAS data image, if it exists.
+    if (nullptr != i_data.image)
     {
-        trace::err("No RAS data defined for chip type: 0x%08x",
-                   i_signature.getChip().getType());
-        throw; // caught later downstream
+        const auto& image = *i_data.image;
+
+        o_flags = image.getSignatureFlags(i_signature);
+
+        auto action = image.getDefaultAction();
+        if (ras_data_image::NONE != action)
+        {
+            std::vector<std::optional<FlagBits>> cache(image.getNumActions());
+            o_flags |= __getActionFlags(image, action, cache);
+        }
+
+        return o_flags;
     }
 
+    const auto& data = *i_data.file;
+
     // Get the signature keys. All are hex (lower case) with no prefix.
     char buf[5];
     sprintf(buf, "%04x", i_signature.getId());
@@ -132,46 +219,69 @@ bool RasDataParser::isFlagSet(const libhei::Signature& i_signature,
     sprintf(buf, "%02x", i_signature.getBit());
     std::string bit{buf};
 
-    // Get the list of flags in string format from the data.
     try
     {
-        auto flags = data.at("signatures")
-                         .at(id)
-                         .at(bit)
-                         .at("flags")
-                         .get<std::vector<std::string>>();
-
-        // Check if the input flag exists
-        if (flags.end() != std::find(flags.begin(), flags.end(), strFlag))
+        const auto& flags = data.at("signatures").at(id).at(bit).at("flags");
+        for (const auto& flag : flags)
         {
-            o_isFlagSet = true;
+            __setFlag(o_flags, flag.get_ref<const std::string&>());
         }
     }
     catch (const nlohmann::json::out_of_range& e)
     {
-        // Do nothing. Assume there is no flag defined. If for some reason
-        // the `id` or `bit` were not defined, that will be cause below when the
-        // signture is parsed.
+        // Do nothing. Assume there is no flag defined.
     }
 
-    // If the flag hasn't been found, check if it was defined as part of the
-    // action for this input signature.
-    if (!o_isFlagSet)
+    try
     {
-        const auto action = parseSignature(data, i_signature);
-        try
-        {
-            __checkActionForFlag(action, strFlag, data);
-        }
-        catch (const nlohmann::json::out_of_range& e)
+        std::map<std::string, FlagBits> cache;
+        o_flags |= __getActionFlags(data, "level2_M_th1", cache);
+    }
+    catch (const nlohmann::json::out_of_range& e)
+    {
+        // Again, do nothing. Assume there is no flag defined. If for some
+        // reason the action is not defined, that will be handled later when
+        // attempting to get the resolution.
+    }
+
+    return o_flags;
+}
+
+//------------------------------------------------------------------------------
+
+RasDataParser::FlagBits RasDataParser::getFlags(
+    const libhei::Signature& i_signature) const
+{
+    const auto type = i_signature.getChip().getType();
+
+    {
+        std::scoped_lock lock{iv_mutex};
+
+        // Builds the signature index for this chip type, if needed.
+        loadDataFile(type);
+
+        auto itr = iv_signatureIndex.find(
+            getSignatureKey(type, i_signature.getId(),
+                            i_signature.getInstance(), i_signature.getBit()));
+
+        if (iv_signatureIndex.end() != itr)
         {
-            // Again, do nothing. Assume there is no flag defined. If for some
-            // reason the action is not defined, that will be handled later when
-            // attempting to get the resolution.
+            return itr->second.flags;
         }
     }
 
-    return o_isFlagSet;
+    // The signature is not defined in the RAS data. This is not expected and
+    // will be traced when getting the resolution. Note that this will throw an
+    // exception if there is no RAS data for the chip type.
+    return __getUndefinedFlags(getDataView(type), i_signature);
+}
+
+//------------------------------------------------------------------------------
+
+bool RasDataParser::isFlagSet(const libhei::Signature& i_signature,
+                              const RasDataFlags i_flag) const
+{
+    return getFlags(i_signature).test(i_flag);
 }
 
 //------------------------------------------------------------------------------
@@ -181,28 +291,336 @@ unsigned int RasDataParser::getVersion(
 {
     unsigned int o_version = 0;
 
-    nlohmann::json data;
-    try
+    const auto data = getDataView(i_signature.getChip().getType());
+
+    // Use the compiled RAS data image, if it exists.
+    if (nullptr != data.image)
     {
-        data = iv_dataFiles.at(i_signature.getChip().getType());
+        o_version = data.image->getVersion();
     }
-    catch (const std::out_of_range& e)
+    else
     {
-        trace::err("No RAS data defined for chip type: 0x%08x",
-                   i_signature.getChip().getType());
-        throw; // caught later downstream
+        o_version = data.file->at("version").get<unsigned int>();
     }
 
-    o_version = data.at("version").get<unsigned int>();
-
     return o_version;
 }
 
 //------------------------------------------------------------------------------
 
+using FilterRule = RasDataParser::FilterRule;
+
+// The filter rule attention types and analysis types mapping to their
+// corresponding enums.
+// clang-format off
+const std::map<std::string, libhei::AttentionType_t> __attnTypeMap =
+{
+    {"CHIP_CS",     libhei::ATTN_TYPE_CHIP_CS},
+    {"UNIT_CS",     libhei::ATTN_TYPE_UNIT_CS},
+    {"RECOVERABLE", libhei::ATTN_TYPE_RECOVERABLE},
+    {"SP_ATTN",     libhei::ATTN_TYPE_SP_ATTN},
+    {"HOST_ATTN",   libhei::ATTN_TYPE_HOST_ATTN},
+};
+
+const std::map<std::string, AnalysisType> __analysisTypeMap =
+{
+    {"SYSTEM_CHECKSTOP",    AnalysisType::SYSTEM_CHECKSTOP},
+    {"TERMINATE_IMMEDIATE", AnalysisType::TERMINATE_IMMEDIATE},
+    {"MANUAL",              AnalysisType::MANUAL},
+};
+// clang-format on
+
+/**
+ * @brief  Returns a bit mask of the values listed by the given keyword of a
+ *         filter rule.
+ * @param  i_rule A filter rule from a RAS data file.
+ * @param  i_key  The target keyword.
+ * @param  i_map  The mapping of each string value to its bit position.
+ * @return The bit mask, all values in the map if the keyword is not defined.
+ */
+template <typename T>
+uint8_t __getMask(const nlohmann::json& i_rule, const char* i_key,
+                  const std::map<std::string, T>& i_map)
+{
+    uint8_t o_mask = 0;
+
+    if (!i_rule.contains(i_key))
+    {
+        for (const auto& [name, value] : i_map)
+        {
+            o_mask |= 1 << static_cast<unsigned int>(value);
+        }
+    }
+    else
+    {
+        for (const auto& name : i_rule.at(i_key))
+        {
+            auto value = i_map.at(name.get_ref<const std::string&>());
+            o_mask |= 1 << static_cast<unsigned int>(value);
+        }
+    }
+
+    return o_mask;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Compiles the `filter_rules` section of a RAS data file.
+ * @param  i_data The parsed RAS data file.
+ * @return The filter rules, sorted by rank. A rule with multiple nodes is
+ *         expanded into one rule per node.
+ * @throw  std::runtime_error if the filter rules are missing or the version is
+ *         not supported.
+ */
+std::vector<FilterRule> __compileFilterRules(const nlohmann::json& i_data)
+{
+    using ras_data_image::NodeMatch;
+
+    std::vector<FilterRule> o_rules;
+
+    // Without the filter rules, there would be no root cause at all (not even
+    // for a manual attention). So the section is required.
+    if (!i_data.contains("filter_rules"))
+    {
+        throw std::runtime_error("Missing filter rules");
+    }
+
+    const auto& section = i_data.at("filter_rules");
+
+    auto version = section.at("version").get<unsigned int>();
+    if (RasDataParser::FILTER_RULES_VERSION != version)
+    {
+        throw std::runtime_error("Unsupported filter rules version: " +
+                                 std::to_string(version));
+    }
+
+    for (const auto& r : section.at("rules"))
+    {
+        FilterRule rule{};
+
+        rule.rank = r.at("rank").get<unsigned int>();
+
+        rule.bits = std::numeric_limits<uint64_t>::max();
+        if (r.contains("bits"))
+        {
+            rule.bits = 0;
+            for (const auto& bit : r.at("bits"))
+            {
+                rule.bits |= uint64_t{1} << bit.get<unsigned int>();
+            }
+        }
+
+        rule.attnTypes = __getMask(r, "attn_types", __attnTypeMap);
+        rule.analysisTypes = __getMask(r, "analysis_types", __analysisTypeMap);
+
+        for (const auto& flag : r.value("any_flags", nlohmann::json::array()))
+        {
+            __setFlag(rule.anyFlags, flag.get_ref<const std::string&>());
+        }
+
+        for (const auto& flag : r.value("no_flags", nlohmann::json::array()))
+        {
+            __setFlag(rule.noFlags, flag.get_ref<const std::string&>());
+        }
+
+        rule.noOcmbAttns = r.value("no_ocmb_attns", false);
+
+        // The node names are only hashed once, here.
+        if (r.contains("nodes"))
+        {
+            rule.nodeMatch = NodeMatch::EQUAL;
+            for (const auto& node : r.at("nodes"))
+            {
+                rule.node = libhei::hash<libhei::NodeId_t>(
+                    node.get_ref<const std::string&>());
+                o_rules.push_back(rule);
+            }
+        }
+        else if (r.contains("exclude_node"))
+        {
+            rule.nodeMatch = NodeMatch::NOT_EQUAL;
+            rule.node = libhei::hash<libhei::NodeId_t>(
+                r.at("exclude_node").get_ref<const std::string&>());
+            o_rules.push_back(rule);
+        }
+        else
+        {
+            rule.nodeMatch = NodeMatch::ANY;
+            o_rules.push_back(rule);
+        }
+    }
+
+    // Rules with the same rank must remain in the order they were defined.
+    std::ranges::stable_sort(o_rules, {}, &FilterRule::rank);
+
+    return o_rules;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Same as above, except the filter rules are taken from a RAS data
+ *         image. These have already been expanded and sorted by the compiler.
+ */
+std::vector<FilterRule> __compileFilterRules(const RasDataImage& i_image)
+{
+    std::vector<FilterRule> o_rules;
+
+    // The compiler does not create an image without filter rules. So this can
+    // only be an invalid image.
+    auto version = i_image.getFilterRulesVersion();
+    if (0 == version)
+    {
+        throw std::runtime_error("Missing filter rules");
+    }
+
+    if (RasDataParser::FILTER_RULES_VERSION != version)
+    {
+        throw std::runtime_error("Unsupported filter rules version: " +
+                                 std::to_string(version));
+    }
+
+    for (const auto& e : i_image.getFilterRules())
+    {
+        o_rules.push_back(
+            {e.rank, e.nodeMatch, e.node,
+             uint64_t{e.bits[1]} << 32 | e.bits[0], e.attnTypes,
+             e.analysisTypes, FlagBits{e.anyFlags}, FlagBits{e.noFlags},
+             0 != (e.conditions & ras_data_image::NO_OCMB_ATTNS)});
+    }
+
+    return o_rules;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Returns the chip type of the given RAS data file without parsing the
+ *         entire file. The file is fully parsed and validated when loaded.
+ * @param  i_path The path to a RAS data file.
+ * @return The value of the `model_ec` keyword.
+ */
+libhei::ChipType_t __getModelEc(const fs::path& i_path)
+{
+    // Only the pages up to the keyword are read from the file.
+    util::MappedFile file{i_path, util::MappedFile::Access::SEQUENTIAL};
+    auto contents = file.chars();
+
+    // The value is a string representation of a 32-bit hex value (see schema).
+    // The first occurrence of the keyword is assumed to be the top level
+    // keyword. This is verified when the file is fully parsed.
+    auto pos = contents.find("\"model_ec\"");
+    pos = contents.find(':', pos);
+    pos = contents.find('"', pos);
+    if (std::string_view::npos == pos)
+    {
+        throw std::runtime_error("model_ec not found");
+    }
+
+    return std::stoul(std::string{contents.substr(pos + 1, 8)}, nullptr, 16);
+}
+
+//------------------------------------------------------------------------------
+
 void RasDataParser::initDataFiles()
 {
-    iv_dataFiles.clear(); // initially empty
+    iv_builtinImages.clear(); // initially empty
+    iv_imagePaths.clear();    // initially empty
+    iv_dataPaths.clear();     // initially empty
+
+    // Index each of the RAS data images built into the program by chip type.
+    // These were validated against the schema at build time, unless the
+    // validation was disabled.
+    for (const auto& data : getBuiltinRasData())
+    {
+        RasDataImage image{data};
+
+        auto ret = iv_builtinImages.emplace(image.getChipType(), data);
+        assert(ret.second); // Should not have duplicate entries
+    }
+
+    // There is no need to look for any data files if the RAS data is built
+    // into the program.
+    if (!iv_builtinImages.empty())
+    {
+        return;
+    }
+
+    // Get the compiled RAS data images from the package `data` subdirectory.
+    fs::path dataDir{PACKAGE_DIR "ras-data"};
+    std::vector<fs::path> imagePaths;
+    util::findFiles(dataDir, R"(.*\.bin)", imagePaths);
+
+    // Index each of the images by chip type. Only the image header is read. The
+    // images are not loaded until needed.
+    for (const auto& path : imagePaths)
+    {
+        // Trace each data file for debug.
+        trace::inf("File found: path=%s", path.string().c_str());
+
+        ras_data_image::Header header{};
+
+        std::ifstream file{path, std::ios::binary};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!file.good() || ras_data_image::MAGIC != header.magic ||
+            ras_data_image::FORMAT_VERSION != header.formatVersion)
+        {
+            // Not fatal, the JSON data file will be used instead.
+            trace::err("Invalid image header: %s", path.string().c_str());
+            continue;
+        }
+
+        auto ret = iv_imagePaths.emplace(header.chipType, path);
+        assert(ret.second); // Should not have duplicate entries
+
+        // Keep the associated JSON data file as a fallback in case the image
+        // fails to load.
+        auto jsonPath = fs::path{path}.replace_extension(".json");
+        if (fs::exists(jsonPath))
+        {
+            iv_dataPaths.emplace(header.chipType, jsonPath);
+        }
+    }
+
+    // Get the RAS data files from the package `data` subdirectory.
+    std::vector<fs::path> dataPaths;
+    util::findFiles(dataDir, R"(.*\.json)", dataPaths);
+
+    // Index each of the data files that do not have an image by chip type.
+    for (const auto& path : dataPaths)
+    {
+        // Skip any data files that have already been indexed with an image.
+        if (iv_dataPaths.end() !=
+            std::find_if(iv_dataPaths.begin(), iv_dataPaths.end(),
+                         [&path](const auto& e) { return path == e.second; }))
+        {
+            continue;
+        }
+
+        // Trace each data file for debug.
+        trace::inf("File found: path=%s", path.string().c_str());
+
+        try
+        {
+            auto ret = iv_dataPaths.emplace(__getModelEc(path), path);
+            assert(ret.second); // Should not have duplicate entries
+        }
+        catch (...)
+        {
+            trace::err("Failed to parse file: %s", path.string().c_str());
+            throw; // caught later downstream
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void RasDataParser::initSchemaFiles() const
+{
+    iv_schemaFiles.clear();  // initially empty
+    iv_schemaHashes.clear(); // initially empty
 
     // Get the RAS data schema files from the package `schema` subdirectory.
     fs::path schemaDir{PACKAGE_DIR "schema"};
@@ -211,28 +629,31 @@ void RasDataParser::initDataFiles()
     util::findFiles(schemaDir, schemaRegex, schemaPaths);
 
     // Parse each of the schema files.
-    std::map<unsigned int, nlohmann::json> schemaFiles;
     for (const auto& path : schemaPaths)
     {
         // Trace each data file for debug.
         trace::inf("File found: path=%s", path.string().c_str());
 
-        // Open the file.
-        std::ifstream file{path};
-        assert(file.good()); // The file must be readable.
+        // Map the file instead of copying the entire contents into memory.
+        util::MappedFile file{path, util::MappedFile::Access::SEQUENTIAL};
+        auto contents = file.chars();
 
         try
         {
             // Parse the JSON.
-            auto schema = nlohmann::json::parse(file);
+            auto schema =
+                nlohmann::json::parse(contents.begin(), contents.end());
 
             // Get the schema version.
             auto version = schema.at("version").get<unsigned int>();
             assert(2 <= version); // check support version
 
             // Keep track of the schemas.
-            auto ret = schemaFiles.emplace(version, schema);
+            auto ret = iv_schemaFiles.emplace(version, std::move(schema));
             assert(ret.second); // Should not have duplicate entries
+
+            iv_schemaHashes.emplace(version,
+                                    util::ValidationCache::hash(contents));
         }
         catch (...)
         {
@@ -241,96 +662,299 @@ void RasDataParser::initDataFiles()
         }
     }
 
-    // Get the RAS data files from the package `data` subdirectory.
-    fs::path dataDir{PACKAGE_DIR "ras-data"};
-    std::vector<fs::path> dataPaths;
-    util::findFiles(dataDir, R"(.*\.json)", dataPaths);
+    iv_validationCache.emplace(PACKAGE_STATE_DIR "ras-data-validation");
 
-    // Parse each of the data files.
-    for (const auto& path : dataPaths)
+    iv_schemaFilesLoaded = true;
+}
+
+//------------------------------------------------------------------------------
+
+void RasDataParser::loadDataFile(libhei::ChipType_t i_type) const
+{
+    // Nothing to do if the data has already been loaded.
+    if (iv_dataImages.contains(i_type) || iv_dataFiles.contains(i_type))
     {
-        // Trace each data file for debug.
-        trace::inf("File found: path=%s", path.string().c_str());
+        return;
+    }
+
+    // The RAS data built into the program is always used, if it exists.
+    auto builtinItr = iv_builtinImages.find(i_type);
+    if (iv_builtinImages.end() != builtinItr)
+    {
+        RasDataImage image{builtinItr->second};
+
+        indexSignatures(i_type, image);
+
+        iv_dataImages.emplace(i_type, std::move(image));
+        return;
+    }
 
-        // Open the file.
-        std::ifstream file{path};
-        assert(file.good()); // The file must be readable.
+    // Prefer the compiled RAS data image, if it exists.
+    auto imageItr = iv_imagePaths.find(i_type);
+    if (iv_imagePaths.end() != imageItr)
+    {
+        const auto& path = imageItr->second;
+
+        trace::inf("Loading RAS data image: path=%s", path.string().c_str());
 
         try
         {
-            // Parse the JSON.
-            const auto data = nlohmann::json::parse(file);
+            RasDataImage image{path};
 
-            // Get the data version.
-            auto version = data.at("version").get<unsigned int>();
-            assert(2 <= version); // check support version
+            if (i_type != image.getChipType())
+            {
+                throw std::runtime_error("Unexpected chip type");
+            }
 
-            // Get the schema for this file.
-            auto schema = schemaFiles.at(version);
+            indexSignatures(i_type, image);
 
-            // Validate the data against the schema.
-            assert(util::validateJson(schema, data));
+            iv_dataImages.emplace(i_type, std::move(image));
+            return;
+        }
+        catch (const std::exception& e)
+        {
+            // Not fatal, the JSON data file will be used instead.
+            trace::err("Failed to load image: %s: %s", path.string().c_str(),
+                       e.what());
+        }
+    }
 
-            // Get the chip model/EC level from the data. The value is currently
-            // stored as a string representation of the hex value. So it will
-            // have to be converted to an integer.
-            libhei::ChipType_t chipType =
-                std::stoul(data.at("model_ec").get<std::string>(), nullptr, 16);
+    auto dataItr = iv_dataPaths.find(i_type);
+    if (iv_dataPaths.end() == dataItr)
+    {
+        return; // There is no RAS data for this chip type.
+    }
 
-            // So far, so good. Add the entry.
-            auto ret = iv_dataFiles.emplace(chipType, data);
-            assert(ret.second); // Should not have duplicate entries
-        }
-        catch (...)
+    const auto& path = dataItr->second;
+
+    trace::inf("Loading RAS data file: path=%s", path.string().c_str());
+
+    // The schema files are only needed when a JSON data file is loaded.
+    if (!iv_schemaFilesLoaded)
+    {
+        initSchemaFiles();
+    }
+
+    // Map the file instead of copying the entire contents into memory.
+    util::MappedFile file{path, util::MappedFile::Access::SEQUENTIAL};
+    auto contents = file.chars();
+
+    try
+    {
+        // Parse the JSON.
+        auto data = nlohmann::json::parse(contents.begin(), contents.end());
+
+        // Get the data version.
+        auto version = data.at("version").get<unsigned int>();
+        assert(2 <= version); // check support version
+
+        // Get the schema for this file.
+        const auto& schema = iv_schemaFiles.at(version);
+
+        // Validate the data against the schema. This is skipped if the same
+        // data and schema have already been validated.
+        auto hash = util::ValidationCache::hash(contents,
+                                                iv_schemaHashes.at(version));
+        if (!iv_validationCache->validate(schema, data, hash))
         {
-            trace::err("Failed to parse file: %s", path.string().c_str());
-            throw; // caught later downstream
+            throw std::runtime_error("RAS data failed schema validation");
         }
+
+        trace::inf("RAS data validation cache: hits=%zu misses=%zu",
+                   iv_validationCache->getHits(),
+                   iv_validationCache->getMisses());
+
+        // Get the chip model/EC level from the data. The value is currently
+        // stored as a string representation of the hex value. So it will
+        // have to be converted to an integer.
+        libhei::ChipType_t chipType =
+            std::stoul(data.at("model_ec").get<std::string>(), nullptr, 16);
+        assert(i_type == chipType); // Should match the index
+
+        // Compile all of the actions.
+        indexSignatures(chipType, data);
+
+        // So far, so good. Add the entry.
+        auto ret = iv_dataFiles.emplace(chipType, std::move(data));
+        assert(ret.second); // Should not have duplicate entries
+    }
+    catch (...)
+    {
+        trace::err("Failed to parse file: %s", path.string().c_str());
+        throw; // caught later downstream
     }
 }
 
 //------------------------------------------------------------------------------
 
-std::string RasDataParser::parseSignature(
-    const nlohmann::json& i_data, const libhei::Signature& i_signature) const
+void RasDataParser::indexSignatures(libhei::ChipType_t i_type,
+                                    const RasDataImage& i_image) const
 {
-    // Get the signature keys. All are hex (lower case) with no prefix.
-    char buf[5];
-    sprintf(buf, "%04x", i_signature.getId());
-    std::string id{buf};
+    auto filterRules = __compileFilterRules(i_image);
 
-    sprintf(buf, "%02x", i_signature.getBit());
-    std::string bit{buf};
+    // Each action is only compiled once.
+    std::map<uint32_t, std::shared_ptr<Resolution>> resolutions;
+    std::vector<std::optional<FlagBits>> flags(i_image.getNumActions());
+
+    std::unordered_map<uint64_t, SignatureData> index;
 
-    sprintf(buf, "%02x", i_signature.getInstance());
-    std::string inst{buf};
+    for (const auto& s : i_image.getSignatures())
+    {
+        // The signature key is (id << 16 | instance << 8 | bit).
+        SignatureData data{};
 
-    std::string action;
+        // Note that parseAction() will detect any cyclic action references
+        // before the flags are resolved.
+        data.resolution = parseAction(i_image, s.action, resolutions);
 
-    try
+        data.flags = i_image.getSignatureFlags(s.key >> 16, s.key & 0xff);
+        data.flags |= __getActionFlags(i_image, s.action, flags);
+
+        index.emplace(static_cast<uint64_t>(i_type) << 32 | s.key,
+                      std::move(data));
+    }
+
+    std::shared_ptr<Resolution> defaultResolution;
+
+    auto defaultAction = i_image.getDefaultAction();
+    if (ras_data_image::NONE != defaultAction)
     {
-        action =
-            i_data.at("signatures").at(id).at(bit).at(inst).get<std::string>();
+        defaultResolution = parseAction(i_image, defaultAction, resolutions);
     }
-    catch (const nlohmann::json::out_of_range& e)
+
+    // Everything compiled successfully.
+    iv_signatureIndex.merge(index);
+    iv_defaultResolutions[i_type] = defaultResolution;
+    iv_filterRules[i_type] = std::move(filterRules);
+}
+
+//------------------------------------------------------------------------------
+
+void RasDataParser::indexSignatures(libhei::ChipType_t i_type,
+                                    const nlohmann::json& i_data) const
+{
+    auto filterRules = __compileFilterRules(i_data);
+
+    // Each action is only compiled once.
+    std::map<std::string, std::shared_ptr<Resolution>> resolutions;
+    std::map<std::string, FlagBits> flags;
+
+    std::unordered_map<uint64_t, SignatureData> index;
+
+    for (const auto& [id, bits] : i_data.at("signatures").items())
     {
-        trace::err("No action defined for signature: %s %s %s", id.c_str(),
-                   bit.c_str(), inst.c_str());
+        auto nodeId = std::stoul(id, nullptr, 16);
+
+        for (const auto& [bit, insts] : bits.items())
+        {
+            auto bitPos = std::stoul(bit, nullptr, 16);
+
+            FlagBits sigFlags{};
+            if (insts.contains("flags"))
+            {
+                for (const auto& flag : insts.at("flags"))
+                {
+                    __setFlag(sigFlags, flag.get_ref<const std::string&>());
+                }
+            }
+
+            for (const auto& [inst, action] : insts.items())
+            {
+                if ("flags" == inst)
+                {
+                    continue;
+                }
+
+                const auto& name = action.get_ref<const std::string&>();
+
+                SignatureData data{};
 
-        // Default to 'level2_M_th1' if no signature is found.
-        action = "level2_M_th1";
+                // Note that parseAction() will detect any cyclic action
+                // references before the flags are resolved.
+                data.resolution = parseAction(i_data, name, resolutions);
+                data.flags = sigFlags | __getActionFlags(i_data, name, flags);
+
+                index.emplace(getSignatureKey(i_type, nodeId,
+                                              std::stoul(inst, nullptr, 16),
+                                              bitPos),
+                              std::move(data));
+            }
+        }
+    }
+
+    std::shared_ptr<Resolution> defaultResolution;
+
+    if (i_data.at("actions").contains("level2_M_th1"))
+    {
+        defaultResolution = parseAction(i_data, "level2_M_th1", resolutions);
     }
 
-    // Return the action.
-    return action;
+    // Everything compiled successfully.
+    iv_signatureIndex.merge(index);
+    iv_defaultResolutions[i_type] = defaultResolution;
+    iv_filterRules[i_type] = std::move(filterRules);
+}
+
+//------------------------------------------------------------------------------
+
+std::span<const RasDataParser::FilterRule> RasDataParser::getFilterRules(
+    libhei::ChipType_t i_type) const
+{
+    std::scoped_lock lock{iv_mutex};
+
+    loadDataFile(i_type);
+
+    // Note that the map entries are never removed once loaded. So it is safe
+    // to return a view of them after the lock is released.
+    auto itr = iv_filterRules.find(i_type);
+    if (iv_filterRules.end() == itr)
+    {
+        trace::err("No RAS data defined for chip type: 0x%08x", i_type);
+        throw std::out_of_range("No RAS data defined for chip type");
+    }
+
+    return itr->second;
+}
+
+//------------------------------------------------------------------------------
+
+RasDataParser::DataView RasDataParser::getDataView(
+    libhei::ChipType_t i_type) const
+{
+    std::scoped_lock lock{iv_mutex};
+
+    loadDataFile(i_type);
+
+    // Note that the map entries are never removed once loaded. So it is safe
+    // to return pointers to them after the lock is released.
+    DataView o_view{};
+
+    auto imageItr = iv_dataImages.find(i_type);
+    if (iv_dataImages.end() != imageItr)
+    {
+        o_view.image = &(imageItr->second);
+        return o_view;
+    }
+
+    auto fileItr = iv_dataFiles.find(i_type);
+    if (iv_dataFiles.end() != fileItr)
+    {
+        o_view.file = &(fileItr->second);
+        return o_view;
+    }
+
+    // There is no RAS data for this chip type. The exception will be caught
+    // later downstream.
+    trace::err("No RAS data defined for chip type: 0x%08x", i_type);
+    throw std::out_of_range("No RAS data defined for chip type");
 }
 
 //------------------------------------------------------------------------------
 
 std::tuple<callout::BusType, std::string> RasDataParser::parseBus(
-    const nlohmann::json& i_data, const std::string& i_name)
+    const nlohmann::json& i_data, const std::string& i_name) const
 {
-    auto bus = i_data.at("buses").at(i_name);
+    const auto& bus = i_data.at("buses").at(i_name);
 
     // clang-format off
     static const std::map<std::string, callout::BusType> m =
@@ -340,7 +964,7 @@ std::tuple<callout::BusType, std::string> RasDataParser::parseBus(
     };
     // clang-format on
 
-    auto busType = m.at(bus.at("type").get<std::string>());
+    auto busType = m.at(bus.at("type").get_ref<const std::string&>());
 
     std::string unitPath{}; // default empty if unit does not exist
     if (bus.contains("unit"))
@@ -355,15 +979,25 @@ std::tuple<callout::BusType, std::string> RasDataParser::parseBus(
 //------------------------------------------------------------------------------
 
 std::shared_ptr<Resolution> RasDataParser::parseAction(
-    const nlohmann::json& i_data, const std::string& i_action)
+    const nlohmann::json& i_data, const std::string& i_action,
+    std::map<std::string, std::shared_ptr<Resolution>>& io_cache) const
 {
-    auto o_list = std::make_shared<ResolutionList>();
+    // Reuse the resolution if this action has already been parsed.
+    auto [itr, inserted] = io_cache.emplace(i_action, nullptr);
+    if (!inserted)
+    {
+        // This function will be called recursively and we want to prevent
+        // cyclic recursion. An action that is still being parsed does not have
+        // a resolution yet.
+        if (nullptr == itr->second)
+        {
+            throw std::runtime_error("Cyclic RAS data action: " + i_action);
+        }
+
+        return itr->second;
+    }
 
-    // This function will be called recursively and we want to prevent cyclic
-    // recursion.
-    static std::vector<std::string> stack;
-    assert(stack.end() == std::find(stack.begin(), stack.end(), i_action));
-    stack.push_back(i_action);
+    auto o_list = std::make_shared<ResolutionList>();
 
     // Iterate the action list and apply the changes.
     for (const auto& a : i_data.at("actions").at(i_action))
@@ -374,7 +1008,7 @@ std::shared_ptr<Resolution> RasDataParser::parseAction(
         {
             auto name = a.at("name").get<std::string>();
 
-            o_list->push(parseAction(i_data, name));
+            o_list->push(parseAction(i_data, name, io_cache));
         }
         else if ("callout_self" == type)
         {
@@ -487,15 +1121,176 @@ std::shared_ptr<Resolution> RasDataParser::parseAction(
         }
     }
 
-    // Done with this action pop it off the stack.
-    stack.pop_back();
+    // Done with this action. Note that the iterator is still valid because
+    // std::map iterators are not invalidated by insertion.
+    itr->second = o_list;
+
+    return o_list;
+}
+
+//------------------------------------------------------------------------------
+
+std::shared_ptr<Resolution> RasDataParser::parseAction(
+    const RasDataImage& i_image, uint32_t i_action,
+    std::map<uint32_t, std::shared_ptr<Resolution>>& io_cache) const
+{
+    using namespace ras_data_image;
+
+    // Reuse the resolution if this action has already been parsed.
+    auto [itr, inserted] = io_cache.emplace(i_action, nullptr);
+    if (!inserted)
+    {
+        // An action that is still being parsed does not have a resolution yet.
+        if (nullptr == itr->second)
+        {
+            throw std::runtime_error(
+                "Cyclic RAS data action: " +
+                std::string{i_image.getActionName(i_action)});
+        }
+
+        return itr->second;
+    }
+
+    auto o_list = std::make_shared<ResolutionList>();
+
+    // The enum values in the image are indexes into these arrays. They must
+    // match the order defined in the RAS data compiler.
+
+    // clang-format off
+    static const callout::ClockType* clocks[] =
+    {
+        &callout::ClockType::OSC_REF_CLOCK_0,
+        &callout::ClockType::OSC_REF_CLOCK_1,
+        &callout::ClockType::TOD_CLOCK,
+    };
+
+    static const callout::Procedure* procedures[] =
+    {
+        &callout::Procedure::NEXTLVL,
+        &callout::Procedure::SUE_SEEN,
+    };
+
+    static const callout::PartType* parts[] =
+    {
+        &callout::PartType::PNOR,
+    };
+
+    static const callout::BusType* buses[] =
+    {
+        &callout::BusType::SMP_BUS,
+        &callout::BusType::OMI_BUS,
+    };
+    // clang-format on
+
+    // Returns the bus type and unit path for the given bus index.
+    auto getBus = [&i_image](uint32_t i_bus) {
+        const auto& bus = i_image.getBus(i_bus);
+
+        std::string unitPath{}; // default empty if unit does not exist
+        if (NONE != bus.unit)
+        {
+            unitPath = i_image.getString(i_image.getUnit(bus.unit).path);
+        }
+
+        return std::make_tuple(*buses[bus.type], unitPath);
+    };
+
+    // Iterate the action list and apply the changes.
+    for (const auto& a : i_image.getActionElements(i_action))
+    {
+        auto priority = static_cast<callout::Priority>(a.priority);
+        bool guard = (0 != a.guard);
+
+        switch (a.type)
+        {
+            case ElementType::ACTION:
+            {
+                o_list->push(parseAction(i_image, a.arg0, io_cache));
+                break;
+            }
+            case ElementType::CALLOUT_SELF:
+            {
+                std::string path{}; // Must be empty to callout the chip.
+
+                o_list->push(std::make_shared<HardwareCalloutResolution>(
+                    path, priority, guard));
+                break;
+            }
+            case ElementType::CALLOUT_UNIT:
+            {
+                std::string path{
+                    i_image.getString(i_image.getUnit(a.arg0).path)};
+
+                o_list->push(std::make_shared<HardwareCalloutResolution>(
+                    path, priority, guard));
+                break;
+            }
+            case ElementType::CALLOUT_CONNECTED:
+            {
+                auto busData = getBus(a.arg0);
+
+                o_list->push(std::make_shared<ConnectedCalloutResolution>(
+                    std::get<0>(busData), std::get<1>(busData), priority,
+                    guard));
+                break;
+            }
+            case ElementType::CALLOUT_BUS:
+            {
+                auto busData = getBus(a.arg0);
+
+                o_list->push(std::make_shared<BusCalloutResolution>(
+                    std::get<0>(busData), std::get<1>(busData), priority,
+                    guard));
+                break;
+            }
+            case ElementType::CALLOUT_CLOCK:
+            {
+                o_list->push(std::make_shared<ClockCalloutResolution>(
+                    *clocks[a.arg0], priority, guard));
+                break;
+            }
+            case ElementType::CALLOUT_PROCEDURE:
+            {
+                o_list->push(std::make_shared<ProcedureCalloutResolution>(
+                    *procedures[a.arg0], priority));
+                break;
+            }
+            case ElementType::CALLOUT_PART:
+            {
+                o_list->push(std::make_shared<PartCalloutResolution>(
+                    *parts[a.arg0], priority));
+                break;
+            }
+            case ElementType::PLUGIN:
+            {
+                std::string name{i_image.getString(a.arg0)};
+
+                o_list->push(std::make_shared<PluginResolution>(name, a.arg1));
+                break;
+            }
+            case ElementType::FLAG:
+            {
+                // No action, flags will be handled with the isFlagSet function
+                break;
+            }
+            default:
+            {
+                throw std::logic_error("Unsupported action type: " +
+                                       std::to_string(unsigned(a.type)));
+            }
+        }
+    }
+
+    // Done with this action (see above).
+    itr->second = o_list;
 
     return o_list;
 }
 
 //------------------------------------------------------------------------------
 
-callout::Priority RasDataParser::getPriority(const std::string& i_priority)
+callout::Priority RasDataParser::getPriority(
+    const std::string& i_priority) const
 {
     // clang-format off
     static const std::map<std::string, callout::Priority> m =
@@ -1,10 +1,20 @@
 #pragma once
 
+#include <analyzer/ras-data/ras-data-image.hpp>
 #include <analyzer/resolution.hpp>
 #include <hei_main.hpp>
 #include <nlohmann/json.hpp>
+#include <util/data_file.hpp>
 
+#include <bitset>
+#include <filesystem>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace analyzer
 {
@@ -15,12 +25,30 @@ namespace analyzer
 class RasDataParser
 {
   public:
-    /** @brief Default constructor. */
+    /** @brief Default constructor. All RAS data is loaded on demand. */
     RasDataParser()
     {
         initDataFiles();
     }
 
+    /**
+     * @brief Constructor. Only the RAS data for the given chip types is loaded
+     *        and validated up front. Any other chip types will be loaded on
+     *        demand.
+     * @param i_chipTypes The chip types of all active chips (see
+     *                    util::pdbg::getActiveChips()).
+     */
+    explicit RasDataParser(const std::set<libhei::ChipType_t>& i_chipTypes)
+    {
+        initDataFiles();
+
+        std::scoped_lock lock{iv_mutex};
+        for (const auto& type : i_chipTypes)
+        {
+            loadDataFile(type);
+        }
+    }
+
     /** Define all RAS data flags that may be associated with a signature */
     enum RasDataFlags
     {
@@ -38,22 +66,129 @@ class RasDataParser
         ATTN_FROM_OCMB,
     };
 
+    /** A set of RasDataFlags, indexed by the enum values. This is the same
+     *  size as the flag bit mask in the compiled RAS data images. */
+    using FlagBits = std::bitset<32>;
+
+    /** The supported version of the `filter_rules` section of the RAS data. */
+    static constexpr unsigned int FILTER_RULES_VERSION = 1;
+
+    /**
+     * @brief A root cause filter rule, compiled from the `filter_rules` section
+     *        of the RAS data when the data is loaded. A signature matches the
+     *        rule only if it matches every field of the rule.
+     */
+    struct FilterRule
+    {
+        /** Lower ranks take precedence when choosing the root cause. */
+        unsigned int rank;
+
+        /** How the node ID of the signature is matched against `node`. */
+        ras_data_image::NodeMatch nodeMatch;
+
+        /** A node ID. */
+        libhei::NodeId_t node;
+
+        /** The bit positions matched, all bits if all ones. */
+        uint64_t bits;
+
+        /** The attention types matched, indexed by libhei::AttentionType_t. */
+        uint8_t attnTypes;
+
+        /** The analysis types the rule applies to, indexed by AnalysisType. */
+        uint8_t analysisTypes;
+
+        /** The signature must have at least one of these flags, if any. */
+        FlagBits anyFlags;
+
+        /** The signature must have none of these flags. */
+        FlagBits noFlags;
+
+        /** The rule only applies if no signature in the list is from an
+         *  OCMB. */
+        bool noOcmbAttns;
+    };
+
   private:
-    /** @brief The RAS data files. */
-    std::map<libhei::ChipType_t, nlohmann::json> iv_dataFiles;
+    /** @brief The RAS data images built into the program for each chip type
+     *         (see getBuiltinRasData()). If any exist, the data files are not
+     *         used at all. */
+    std::map<libhei::ChipType_t, std::span<const uint8_t>> iv_builtinImages;
+
+    /** @brief The paths to the compiled RAS data images for each chip type. */
+    std::map<libhei::ChipType_t, std::filesystem::path> iv_imagePaths;
+
+    /** @brief The paths to the RAS data files for each chip type. */
+    std::map<libhei::ChipType_t, std::filesystem::path> iv_dataPaths;
+
+    /** @brief The RAS data schema files, loaded only if needed. */
+    mutable std::map<unsigned int, nlohmann::json> iv_schemaFiles;
+
+    /** @brief The content hash of each of the RAS data schema files. */
+    mutable std::map<unsigned int, uint64_t> iv_schemaHashes;
+
+    /** @brief True, if the RAS data schema files have been loaded. */
+    mutable bool iv_schemaFilesLoaded = false;
+
+    /** @brief Records the RAS data files that have already been validated
+     *         against their schema, loaded with the schema files. */
+    mutable std::optional<util::ValidationCache> iv_validationCache;
+
+    /** @brief The RAS data files, loaded on demand. */
+    mutable std::map<libhei::ChipType_t, nlohmann::json> iv_dataFiles;
+
+    /** @brief The compiled RAS data images, loaded on demand. These are
+     *         preferred over the RAS data files, which are only used when an
+     *         image is not available for a chip type. */
+    mutable std::map<libhei::ChipType_t, RasDataImage> iv_dataImages;
+
+    /** @brief Everything needed for a signature defined in the RAS data. */
+    struct SignatureData
+    {
+        /** All flags for the signature, including the flags inherited from
+         *  the signature's action. */
+        FlagBits flags;
+
+        /** The compiled resolution of the signature's action. */
+        std::shared_ptr<Resolution> resolution;
+    };
+
+    /** @brief The data for each signature defined in the loaded RAS data. This
+     *         is built when the RAS data for a chip type is loaded. Each action
+     *         is only compiled once and the resolutions are shared by all
+     *         signatures using the action. The key is the chip type, node ID,
+     *         instance, and bit position (see getSignatureKey()). */
+    mutable std::unordered_map<uint64_t, SignatureData> iv_signatureIndex;
+
+    /** @brief The compiled resolution of the default action for each loaded
+     *         chip type, used for any signature not defined in the RAS data.
+     *         The value is nullptr if the default action is not defined. */
+    mutable std::map<libhei::ChipType_t, std::shared_ptr<Resolution>>
+        iv_defaultResolutions;
+
+    /** @brief The compiled root cause filter rules for each loaded chip type,
+     *         sorted by rank. This is built when the RAS data for a chip type
+     *         is loaded. */
+    mutable std::map<libhei::ChipType_t, std::vector<FilterRule>>
+        iv_filterRules;
+
+    /** @brief Protects the on demand loading of the RAS data. */
+    mutable std::mutex iv_mutex;
 
   public:
     /**
      * @brief Returns a resolution for all the RAS actions needed for the given
-     *        signature.
+     *        signature. The resolution is compiled when the RAS data is loaded
+     *        and is shared by all callers. It must not be modified.
      * @param i_signature The target error signature.
      */
     std::shared_ptr<Resolution> getResolution(
-        const libhei::Signature& i_signature);
+        const libhei::Signature& i_signature) const;
 
     /**
-     * @brief Initializes the signature list within the input isolation data
-     *        with their appropriate flags based on the RAS data files.
+     * @brief Checks if a flag is set for the given signature, either directly
+     *        or by the signature's action. This is a single lookup in the
+     *        flag index for any signature defined in the RAS data.
      * @param i_signature The target error signature.
      * @param i_flag      The flag to check for
      * @return True if the flag is set for the given signature, else false.
@@ -61,6 +196,46 @@ class RasDataParser
     bool isFlagSet(const libhei::Signature& i_signature,
                    const RasDataFlags i_flag) const;
 
+    /**
+     * @brief  Same as isFlagSet() above, except all flags of the signature are
+     *         returned with a single lookup.
+     * @param  i_signature The target error signature.
+     * @return The flags set for the given signature, indexed by RasDataFlags.
+     */
+    FlagBits getFlags(const libhei::Signature& i_signature) const;
+
+    /**
+     * @param  i_type A chip type.
+     * @return The root cause filter rules for the chip type, sorted by rank.
+     *         Empty if none are defined. The rules are loaded on demand and
+     *         are valid for the lifetime of the parser.
+     * @throw  std::out_of_range if there is no RAS data for the chip type.
+     */
+    std::span<const FilterRule> getFilterRules(libhei::ChipType_t i_type) const;
+
+    /**
+     * @brief A read-only view of the RAS data for a single chip type. It refers
+     *        directly to the data stored in the parser (nothing is copied) and
+     *        is valid for the lifetime of the parser. Exactly one of the
+     *        members is set.
+     */
+    struct DataView
+    {
+        /** The compiled RAS data image, if available. */
+        const RasDataImage* image = nullptr;
+
+        /** The parsed RAS data file, if an image is not available. */
+        const nlohmann::json* file = nullptr;
+    };
+
+    /**
+     * @param  i_type A chip type.
+     * @return A read-only view of the RAS data for the chip type. The data is
+     *         loaded on demand, if needed.
+     * @throw  std::out_of_range if there is no RAS data for the chip type.
+     */
+    DataView getDataView(libhei::ChipType_t i_type) const;
+
     /**
      * @brief Returns of the version of the relevant RAS data file for the
      *        input signature.
@@ -71,21 +246,61 @@ class RasDataParser
 
   private:
     /**
-     * @brief Parses all of the RAS data JSON files and validates them against
-     *        the associated schema.
+     * @brief Finds all of the RAS data images built into the program and
+     *        indexes them by chip type. If there are none, finds all of the
+     *        compiled RAS data images and RAS data JSON files and indexes them
+     *        by chip type instead. The files are not loaded until needed.
      */
     void initDataFiles();
 
+    /** @brief Parses all of the RAS data schema files. */
+    void initSchemaFiles() const;
+
     /**
-     * @brief  Parses a signature in the given data file and returns a string
-     *         representing the target action for the signature.
-     * @param  i_data      The parsed RAS data file associated with the
-     *                     signature's chip type.
-     * @param  i_signature The target signature.
-     * @return A string representing the target action for the signature.
+     * @brief Loads the built-in or compiled RAS data image for the given chip
+     *        type, if it exists. Otherwise, parses the RAS data JSON file for
+     *        the chip type and validates it against the associated schema.
+     *        Does nothing if the data is already loaded or if there is no data
+     *        for the chip type. The caller must hold iv_mutex.
+     * @param i_type A chip type.
      */
-    std::string parseSignature(const nlohmann::json& i_data,
-                               const libhei::Signature& i_signature) const;
+    void loadDataFile(libhei::ChipType_t i_type) const;
+
+    /**
+     * @brief Compiles all actions and filter rules in the given RAS data image
+     *        and adds all of its signatures to the signature index. Nothing is
+     *        added if an exception is thrown. The caller must hold iv_mutex.
+     * @param i_type  A chip type.
+     * @param i_image The RAS data image for the chip type.
+     * @throw std::runtime_error if there is a cycle in the action references
+     *        or the filter rules version is not supported.
+     */
+    void indexSignatures(libhei::ChipType_t i_type,
+                         const RasDataImage& i_image) const;
+
+    /**
+     * @brief Same as indexSignatures() above, except the data is taken from a
+     *        parsed RAS data file.
+     * @param i_type A chip type.
+     * @param i_data The parsed RAS data file for the chip type.
+     */
+    void indexSignatures(libhei::ChipType_t i_type,
+                         const nlohmann::json& i_data) const;
+
+    /**
+     * @param  i_type A chip type.
+     * @param  i_id   A node ID.
+     * @param  i_inst A node instance.
+     * @param  i_bit  A bit position within the node.
+     * @return The key for the given signature in the signature index.
+     */
+    static uint64_t getSignatureKey(
+        libhei::ChipType_t i_type, libhei::NodeId_t i_id,
+        libhei::Instance_t i_inst, libhei::BitPosition_t i_bit)
+    {
+        uint32_t sig = i_id << 16 | i_inst << 8 | i_bit;
+        return static_cast<uint64_t>(i_type) << 32 | sig;
+    }
 
     /**
      * @brief  Parses a bus object in the given data file and returns the bus
@@ -96,7 +311,7 @@ class RasDataParser
      * @return A tuple containing the bus type and unit path.
      */
     std::tuple<callout::BusType, std::string> parseBus(
-        const nlohmann::json& i_data, const std::string& i_name);
+        const nlohmann::json& i_data, const std::string& i_name) const;
 
     /**
      * @brief  Parses an action in the given data file and returns the
@@ -104,22 +319,39 @@ class RasDataParser
      * @param  i_data   The parsed RAS data file associated with the signature's
      *                  chip type.
      * @param  i_action The target action to parse from the given RAS data.
+     * @param  io_cache The actions already parsed. Any action referenced by
+     *                  another action is only parsed once and the resolution is
+     *                  shared. An action that is still being parsed has a
+     *                  nullptr entry.
+     * @return A resolution (or nested resolutions) representing the given
+     *         action.
+     * @throw  std::runtime_error if the action references itself, directly or
+     *         indirectly.
+     */
+    std::shared_ptr<Resolution> parseAction(
+        const nlohmann::json& i_data, const std::string& i_action,
+        std::map<std::string, std::shared_ptr<Resolution>>& io_cache) const;
+
+    /**
+     * @brief  Same as parseAction() above, except the action is taken from a
+     *         compiled RAS data image.
+     * @param  i_image  The RAS data image associated with the signature's chip
+     *                  type.
+     * @param  i_action The index of the target action within the image.
+     * @param  io_cache The actions already parsed (see above).
      * @return A resolution (or nested resolutions) representing the given
      *         action.
-     * @note   This function is called recursively because an action could
-     *         reference another action. This function will maintain a stack of
-     *         parsed actions and will assert that the same action cannot be
-     *         parsed more than once in the recursion stack.
      */
-    std::shared_ptr<Resolution> parseAction(const nlohmann::json& i_data,
-                                            const std::string& i_action);
+    std::shared_ptr<Resolution> parseAction(
+        const RasDataImage& i_image, uint32_t i_action,
+        std::map<uint32_t, std::shared_ptr<Resolution>>& io_cache) const;
 
     /**
      * @brief  Returns a callout priority enum value for the given string.
      * @param  i_priority The priority string.
      * @return A callout priority enum value.
      */
-    callout::Priority getPriority(const std::string& i_priority);
+    callout::Priority getPriority(const std::string& i_priority) const;
 };
 
 } // namespace analyzer
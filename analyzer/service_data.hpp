@@ -1,5 +1,7 @@
 #pragma once
 
+#include <assert.h>
+
 #include <analyzer/analyzer_main.hpp>
 #include <analyzer/callout.hpp>
 #include <hei_main.hpp>
@@ -7,10 +9,19 @@
 #include <util/pdbg.hpp>
 
 #include <format>
+#include <memory>
 
 namespace analyzer
 {
 
+/**
+ * @brief An immutable snapshot of the data found during isolation. The
+ *        isolation data contains the entire register dump, which can be quite
+ *        large. So it is built once and then shared (never copied) by
+ *        everything on the analysis path.
+ */
+using IsolationDataPtr = std::shared_ptr<const libhei::IsolationData>;
+
 /**
  * @brief Data regarding required service actions based on the hardware error
  *        analysis.
@@ -22,14 +33,16 @@ class ServiceData
      * @brief Constructor from components.
      * @param i_rootCause    The signature of the root cause attention.
      * @param i_analysisType The type of analysis to perform.
-     * @param i_isoData      The data found during isolation.
+     * @param i_isoData      The data found during isolation. Must not be
+     *                       null.
      */
     ServiceData(const libhei::Signature& i_rootCause,
-                AnalysisType i_analysisType,
-                const libhei::IsolationData& i_isoData) :
+                AnalysisType i_analysisType, IsolationDataPtr i_isoData) :
         iv_rootCause(i_rootCause), iv_analysisType(i_analysisType),
-        iv_isoData(i_isoData)
-    {}
+        iv_isoData(std::move(i_isoData))
+    {
+        assert(nullptr != iv_isoData);
+    }
 
     /** @brief Destructor. */
     ~ServiceData() = default;
@@ -47,8 +60,8 @@ class ServiceData
     /** The type of analysis to perform. */
     const AnalysisType iv_analysisType;
 
-    /** The data found during isolation. */
-    const libhei::IsolationData iv_isoData;
+    /** The data found during isolation (shared, not copied). */
+    const IsolationDataPtr iv_isoData;
 
     /** The list of callouts that will be added to a PEL. */
     nlohmann::json iv_calloutList = nlohmann::json::array();
@@ -73,7 +86,7 @@ class ServiceData
     /** @return The data found during isolation. */
     const libhei::IsolationData& getIsolationData() const
     {
-        return iv_isoData;
+        return *iv_isoData;
     }
 
     /** @return Returns the guard type based on current analysis policies. */
@@ -21,8 +21,13 @@ void addHbStatusRegs()
     if (util::pdbg::queryHardwareAnalysisSupported())
     {
         // We only need this for PRIMARY processor
-        pdbg_target* pibTarget = pdbg_target_from_path(nullptr, "/proc0/pib");
-        pdbg_target* fsiTarget = pdbg_target_from_path(nullptr, "/proc0/fsi");
+        pdbg_target* pibTarget = nullptr;
+        pdbg_target* fsiTarget = nullptr;
+        if (auto proc0 = util::pdbg::getProcTargetsByIndex(0))
+        {
+            pibTarget = proc0->pib;
+            fsiTarget = proc0->fsi;
+        }
 
         uint32_t l_cfamData = 0xFFFFFFFF;
         uint64_t l_scomData1 = 0xFFFFFFFFFFFFFFFFull;
@@ -75,7 +80,8 @@ void addHbStatusRegs()
 void addPrdScratchRegs(std::vector<util::FFDCFile>& o_files)
 {
     // Get primary processor FSI target for CFAM reads
-    pdbg_target* fsiTarget = pdbg_target_from_path(nullptr, "/proc0/fsi");
+    auto proc0 = util::pdbg::getProcTargetsByIndex(0);
+    pdbg_target* fsiTarget = (nullptr != proc0) ? proc0->fsi : nullptr;
 
     if (nullptr == fsiTarget)
     {
@@ -125,6 +131,7 @@ void addPrdScratchRegs(std::vector<util::FFDCFile>& o_files)
                 }
                 else
                 {
+                    file.seal();
                     o_files.push_back(std::move(file));
                 }
             }
@@ -145,63 +152,35 @@ bool recoverableErrors()
 {
     bool recoverableErrors = false; // assume no recoverable attentions
 
-    pdbg_target* target;
-    pdbg_for_each_class_target("proc", target)
+    for (const auto& procTrgts : util::pdbg::getProcTopology())
     {
-        if (PDBG_TARGET_ENABLED == pdbg_target_probe(target))
+        // Enabled processors only (pib target enabled, fsi target found)
+        if (!procTrgts.enabled)
         {
-            auto proc = pdbg_target_index(target); // get processor number
-
-            // Use PIB target to determine if a processor is enabled
-            char path[16];
-            sprintf(path, "/proc%d/pib", proc);
-            pdbg_target* pibTarget = pdbg_target_from_path(nullptr, path);
-
-            // sanity check
-            if (nullptr == pibTarget)
-            {
-                trace::inf("pib path or target not found");
-                continue;
-            }
-
-            // check if pib target is enabled - indicates proc is enabled
-            if (PDBG_TARGET_ENABLED == pdbg_target_probe(pibTarget))
-            {
-                // The processor FSI target is required for CFAM read
-                sprintf(path, "/proc%d/fsi", proc);
-                pdbg_target* fsiTarget = pdbg_target_from_path(nullptr, path);
-
-                // sanity check
-                if (nullptr == fsiTarget)
-                {
-                    trace::inf("fsi path or target not found");
-                    continue;
-                }
+            continue;
+        }
 
-                uint32_t isr_val = 0xffffffff; // invalid isr value
+        uint32_t isr_val = 0xffffffff; // invalid isr value
 
-                // get active attentions on processor
-                if (RC_SUCCESS != fsi_read(fsiTarget, 0x1007, &isr_val))
-                {
-                    // log cfam read error
-                    trace::err("cfam read 0x1007 FAILED");
-                    eventAttentionFail(
-                        (int)AttnSection::attnHandler | ATTN_PDBG_CFAM);
-                }
-                // check for invalid/stale value
-                else if (0xffffffff == isr_val)
-                {
-                    trace::err("cfam read 0x1007 INVALID");
-                    continue;
-                }
-                // check recoverable error status bit
-                else if (0 != (isr_val & RECOVERABLE_ATTN))
-                {
-                    recoverableErrors = true;
-                    break;
-                }
-            } // fsi target enabled
-        } // pib target enabled
+        // get active attentions on processor
+        if (RC_SUCCESS != fsi_read(procTrgts.fsi, 0x1007, &isr_val))
+        {
+            // log cfam read error
+            trace::err("cfam read 0x1007 FAILED");
+            eventAttentionFail((int)AttnSection::attnHandler | ATTN_PDBG_CFAM);
+        }
+        // check for invalid/stale value
+        else if (0xffffffff == isr_val)
+        {
+            trace::err("cfam read 0x1007 INVALID");
+            continue;
+        }
+        // check recoverable error status bit
+        else if (0 != (isr_val & RECOVERABLE_ATTN))
+        {
+            recoverableErrors = true;
+            break;
+        }
     } // next processor
 
     return recoverableErrors;
@@ -2,8 +2,10 @@
 #include <attn/attn_dbus.hpp>
 #include <attn/attn_logging.hpp>
 #include <util/dbus.hpp>
+#include <util/temporary_file.hpp>
 #include <util/trace.hpp>
 
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -52,21 +54,21 @@ int dbusMethod(const std::string& i_path, const std::string& i_interface,
 /** @brief Create a PEL from raw PEL data */
 void createPelRaw(const std::vector<uint8_t>& i_buffer)
 {
-    // Create FFDC file from buffer data
-    util::FFDCFile pelFile{util::FFDCFormat::Text};
-    auto fd = pelFile.getFileDescriptor();
+    // Create a file from buffer data. The raw PEL is passed to the logging
+    // service by path, so unlike FFDC files it must exist in the file system.
+    util::TemporaryFile pelFile{};
 
-    auto filePath = pelFile.getPath(); // path to ffdc file
+    auto filePath = pelFile.getPath(); // path to raw PEL file
 
-    size_t numBytes = write(fd, i_buffer.data(), i_buffer.size());
-    if (i_buffer.size() != numBytes)
+    std::ofstream stream{filePath, std::ios::binary};
+    stream.write(reinterpret_cast<const char*>(i_buffer.data()),
+                 i_buffer.size());
+    stream.close();
+    if (!stream.good())
     {
-        trace::err("%s only %u of %u bytes written", filePath.c_str(), numBytes,
-                   i_buffer.size());
+        trace::err("Unable to write raw PEL file: %s", filePath.c_str());
     }
 
-    lseek(fd, 0, SEEK_SET);
-
     // Additional data for log
     std::map<std::string, std::string> additional;
     additional.emplace("RAWPEL", filePath.string());
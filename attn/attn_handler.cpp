@@ -86,110 +86,86 @@ void attnHandler(Config* i_config)
     // loop through processors looking for active attentions
     trace::inf("Attention handler started");
 
-    pdbg_target* target;
-    pdbg_for_each_class_target("proc", target)
+    for (const auto& procTrgts : util::pdbg::getProcTopology())
     {
-        if (PDBG_TARGET_ENABLED == pdbg_target_probe(target))
+        // Enabled processors only (pib target enabled, fsi target found)
+        if (procTrgts.enabled)
         {
-            auto proc = pdbg_target_index(target); // get processor number
+            pdbg_target* target = procTrgts.proc;
+            auto proc = procTrgts.index; // get processor number
 
-            // Use PIB target to determine if a processor is enabled
-            char path[16];
-            sprintf(path, "/proc%d/pib", proc);
-            pdbg_target* pibTarget = pdbg_target_from_path(nullptr, path);
+            // The processor FSI target is required for CFAM read
+            pdbg_target* fsiTarget = procTrgts.fsi;
 
-            // sanity check
-            if (nullptr == pibTarget)
+            // trace the proc number
+            trace::inf("proc: %u", proc);
+
+            isr_val = 0xffffffff; // invalid isr value
+
+            // get active attentions on processor
+            if (RC_SUCCESS != fsi_read(fsiTarget, 0x1007, &isr_val))
             {
-                trace::inf("pib path or target not found");
+                // log cfam read error
+                trace::err("cfam read 0x1007 FAILED");
+                eventAttentionFail(
+                    (int)AttnSection::attnHandler | ATTN_PDBG_CFAM);
+            }
+            else if (0xffffffff == isr_val)
+            {
+                trace::err("cfam read 0x1007 INVALID");
                 continue;
             }
-
-            // check if pib target is enabled
-            if (PDBG_TARGET_ENABLED == pdbg_target_probe(pibTarget))
+            else
             {
-                // The processor FSI target is required for CFAM read
-                sprintf(path, "/proc%d/fsi", proc);
-                pdbg_target* fsiTarget = pdbg_target_from_path(nullptr, path);
+                // trace isr value
+                trace::inf("cfam 0x1007 = 0x%08x", isr_val);
 
-                // sanity check
-                if (nullptr == fsiTarget)
-                {
-                    trace::inf("fsi path or target not found");
-                    continue;
-                }
+                isr_mask = 0xffffffff; // invalid isr mask
 
-                // trace the proc number
-                trace::inf("proc: %u", proc);
-
-                isr_val = 0xffffffff; // invalid isr value
-
-                // get active attentions on processor
-                if (RC_SUCCESS != fsi_read(fsiTarget, 0x1007, &isr_val))
+                // get interrupt enabled special attentions mask
+                if (RC_SUCCESS != fsi_read(fsiTarget, 0x100d, &isr_mask))
                 {
                     // log cfam read error
-                    trace::err("cfam read 0x1007 FAILED");
+                    trace::err("cfam read 0x100d FAILED");
                     eventAttentionFail(
                         (int)AttnSection::attnHandler | ATTN_PDBG_CFAM);
                 }
-                else if (0xffffffff == isr_val)
+                else if (0xffffffff == isr_mask)
                 {
-                    trace::err("cfam read 0x1007 INVALID");
+                    trace::err("cfam read 0x100d INVALID");
                     continue;
                 }
                 else
                 {
-                    // trace isr value
-                    trace::inf("cfam 0x1007 = 0x%08x", isr_val);
+                    // trace true mask
+                    trace::inf("cfam 0x100d = 0x%08x", isr_mask);
 
-                    isr_mask = 0xffffffff; // invalid isr mask
-
-                    // get interrupt enabled special attentions mask
-                    if (RC_SUCCESS != fsi_read(fsiTarget, 0x100d, &isr_mask))
+                    // SBE vital attention active and not masked?
+                    if (true == activeAttn(isr_val, isr_mask, SBE_ATTN))
                     {
-                        // log cfam read error
-                        trace::err("cfam read 0x100d FAILED");
-                        eventAttentionFail(
-                            (int)AttnSection::attnHandler | ATTN_PDBG_CFAM);
+                        active_attentions.emplace_back(Attention::Vital,
+                                                       handleVital, target,
+                                                       i_config);
                     }
-                    else if (0xffffffff == isr_mask)
+
+                    // Checkstop attention active and not masked?
+                    if (true == activeAttn(isr_val, isr_mask, CHECKSTOP_ATTN))
                     {
-                        trace::err("cfam read 0x100d INVALID");
-                        continue;
+                        active_attentions.emplace_back(Attention::Checkstop,
+                                                       handleCheckstop,
+                                                       target, i_config);
                     }
-                    else
+
+                    // Special attention active and not masked?
+                    if (true == activeAttn(isr_val, isr_mask, SPECIAL_ATTN))
                     {
-                        // trace true mask
-                        trace::inf("cfam 0x100d = 0x%08x", isr_mask);
-
-                        // SBE vital attention active and not masked?
-                        if (true == activeAttn(isr_val, isr_mask, SBE_ATTN))
-                        {
-                            active_attentions.emplace_back(Attention::Vital,
-                                                           handleVital, target,
-                                                           i_config);
-                        }
-
-                        // Checkstop attention active and not masked?
-                        if (true ==
-                            activeAttn(isr_val, isr_mask, CHECKSTOP_ATTN))
-                        {
-                            active_attentions.emplace_back(Attention::Checkstop,
-                                                           handleCheckstop,
-                                                           target, i_config);
-                        }
-
-                        // Special attention active and not masked?
-                        if (true == activeAttn(isr_val, isr_mask, SPECIAL_ATTN))
-                        {
-                            active_attentions.emplace_back(Attention::Special,
-                                                           handleSpecial,
-                                                           target, i_config);
-                        }
-                    } // cfam 0x100d valid
-                } // cfam 0x1007 valid
-            } // fsi target enabled
-        } // pib target enabled
+                        active_attentions.emplace_back(Attention::Special,
+                                                       handleSpecial,
+                                                       target, i_config);
+                    }
+                } // cfam 0x100d valid
+            } // cfam 0x1007 valid
+        } // processor enabled
     } // next processor
 
     // convert to heap, highest priority is at front
@@ -313,16 +289,11 @@ int handleSpecial(Attention* i_attention)
         trace::inf("using libpdbg to get TI info");
 
         // pdbg library uses pib target for get ti info
-        char path[16];
-        sprintf(path, "/proc%d/pib", pdbg_target_index(attnProc));
-        pdbg_target* tiInfoTarget = pdbg_target_from_path(nullptr, path);
+        auto procTrgts = util::pdbg::getProcTargets(attnProc);
 
-        if (nullptr != tiInfoTarget)
+        if (nullptr != procTrgts && procTrgts->enabled)
         {
-            if (PDBG_TARGET_ENABLED == pdbg_target_probe(tiInfoTarget))
-            {
-                sbe_mpipl_get_ti_info(tiInfoTarget, &tiInfo, &tiInfoLen);
-            }
+            sbe_mpipl_get_ti_info(procTrgts->pib, &tiInfo, &tiInfoLen);
         }
 #endif
     }
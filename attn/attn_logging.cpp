@@ -48,16 +48,17 @@ util::FFDCFile createFFDCRawFile(void* i_buffer, size_t i_size)
 {
     util::FFDCFile file{util::FFDCFormat::Custom};
 
-    // Write buffer to file and then reset file description file offset
+    // Write buffer to file and then seal the file, which resets the file
+    // description file offset
     int fd = file.getFileDescriptor();
     size_t numBytes = write(fd, static_cast<char*>(i_buffer), i_size);
     if (i_size != numBytes)
     {
-        trace::err("%s only %u of %u bytes written", file.getPath().c_str(),
-                   numBytes, i_size);
+        trace::err("FFDC raw file only %u of %u bytes written", numBytes,
+                   i_size);
     }
 
-    lseek(fd, 0, SEEK_SET);
+    file.seal();
 
     return file;
 }
@@ -1,4 +1,9 @@
+#include <analyzer/analysis_context.hpp>
 #include <attn/attn_monitor.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <util/dbus.hpp>
+#include <util/pdbg.hpp>
+#include <util/trace.hpp>
 
 namespace attn
 {
@@ -27,6 +32,31 @@ int attnDaemon(Config* i_config)
     }
     else
     {
+        // Load the analyzer data up front so that it does not need to be
+        // loaded during attention handling. This context will be reused by
+        // all analyses while the daemon is running.
+        auto context = std::make_shared<analyzer::AnalysisContext>();
+        if (util::pdbg::queryHardwareAnalysisSupported())
+        {
+            try
+            {
+                auto lock = context->lock();
+                context->refresh();
+            }
+            catch (const std::exception& e)
+            {
+                // Not fatal, the context is refreshed again during analysis.
+                trace::err("Unable to load analysis context: %s", e.what());
+            }
+        }
+        analyzer::AnalysisContext::setActive(context);
+
+        // Keep the cached system identity (i.e. the machine type) up to date
+        // so that analysis does not need to query dbus for it. The signals are
+        // processed by the same event loop as the GPIO monitor.
+        auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+        util::dbus::watchSystemIdentity(*conn);
+
         // Creating a vector of one gpio to monitor
         std::vector<std::unique_ptr<attn::AttnMonitor>> gpios;
         gpios.push_back(
@@ -36,6 +66,9 @@ int attnDaemon(Config* i_config)
 
         // done with line, manually close chip (per gpiod api comments)
         gpiod_line_close_chip(line);
+
+        // done with analysis context
+        analyzer::AnalysisContext::setActive(nullptr);
     }
 
     return rc;
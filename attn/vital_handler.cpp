@@ -33,18 +33,16 @@ bool attemptSbeRecovery(int sbeInstance)
 
     // loop through processors checking attention interrupts
     bool recovered = true;
-    pdbg_target* procTarget;
-    pdbg_for_each_class_target("proc", procTarget)
+    for (const auto& procTrgts : util::pdbg::getProcTopology())
     {
         // active processors only
-        if (PDBG_TARGET_ENABLED !=
-            pdbg_target_probe(util::pdbg::getPibTrgt(procTarget)))
+        if (!procTrgts.enabled)
         {
             continue;
         }
 
         // get cfam is an fsi read
-        pdbg_target* fsiTarget = util::pdbg::getFsiTrgt(procTarget);
+        pdbg_target* fsiTarget = procTrgts.fsi;
         uint32_t int_val;
 
         // get attention interrupts on processor
@@ -86,9 +84,8 @@ bool attemptSbeRecovery(int sbeInstance)
 bool checkstopActive(int procInstance)
 {
     // get fsi target
-    char path[16];
-    sprintf(path, "/proc%d/fsi", procInstance);
-    pdbg_target* fsiTarget = pdbg_target_from_path(nullptr, path);
+    auto procTrgts = util::pdbg::getProcTargetsByIndex(procInstance);
+    pdbg_target* fsiTarget = (nullptr != procTrgts) ? procTrgts->fsi : nullptr;
     if (nullptr == fsiTarget)
     {
         trace::inf("fsi path or target not found");
@@ -0,0 +1,49 @@
+#include <stdlib.h>
+
+#include <benchmarks/alloc-counter.hpp>
+
+#include <atomic>
+#include <new>
+
+namespace
+{
+
+std::atomic<size_t> allocCount{0};
+
+} // namespace
+
+namespace bench
+{
+
+size_t getAllocCount()
+{
+    return allocCount.load(std::memory_order_relaxed);
+}
+
+} // namespace bench
+
+// Replace the global allocation functions so that all allocations are counted.
+// The array, nothrow, and sized variants all call these by default.
+
+void* operator new(size_t i_size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* ptr = malloc(0 == i_size ? 1 : i_size);
+    if (nullptr == ptr)
+    {
+        throw std::bad_alloc{};
+    }
+
+    return ptr;
+}
+
+void operator delete(void* i_ptr) noexcept
+{
+    free(i_ptr);
+}
+
+void operator delete(void* i_ptr, size_t) noexcept
+{
+    free(i_ptr);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace bench
+{
+
+/**
+ * @brief Returns the number of calls to the global operator new since the
+ *        program started. The global operators are replaced in
+ *        alloc-counter.cpp, which must be linked into the benchmark.
+ */
+size_t getAllocCount();
+
+/**
+ * @brief Counts the number of allocations made within a scope and reports the
+ *        average number of allocations per iteration as the `allocs` counter
+ *        of the given benchmark state.
+ */
+class AllocCounter
+{
+  public:
+    /**
+     * @brief Constructor. Starts counting.
+     * @param io_state The benchmark state.
+     */
+    explicit AllocCounter(benchmark::State& io_state) :
+        iv_state(io_state), iv_start(getAllocCount())
+    {}
+
+    /** @brief Destructor. Stops counting and reports the result. */
+    ~AllocCounter()
+    {
+        iv_state.counters["allocs"] =
+            benchmark::Counter(getAllocCount() - iv_start,
+                               benchmark::Counter::kAvgIterations);
+    }
+
+    AllocCounter(const AllocCounter&) = delete;
+    AllocCounter& operator=(const AllocCounter&) = delete;
+
+  private:
+    /** The benchmark state. */
+    benchmark::State& iv_state;
+
+    /** The allocation count when counting started. */
+    const size_t iv_start;
+};
+
+} // namespace bench
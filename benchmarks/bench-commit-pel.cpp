@@ -0,0 +1,45 @@
+#include <analyzer/plugins/plugin.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <analyzer/service_data.hpp>
+#include <benchmarks/alloc-counter.hpp>
+#include <benchmarks/bench-data.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace analyzer
+{
+// Forward reference of commitPel
+uint32_t commitPel(const ServiceData& i_servData);
+} // namespace analyzer
+
+using namespace analyzer;
+
+/** @brief Serializes all of the FFDC for a PEL (callouts, signature list,
+ *         register dump, etc.). The PEL itself is not created in simulation. */
+static void BM_CommitPel(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{{P10_20}};
+
+    auto isoData = std::make_shared<const libhei::IsolationData>(
+        bench::getIsoData(state.range(0)));
+    const auto& list = isoData->getSignatureList();
+
+    ServiceData servData{list.front(), AnalysisType::SYSTEM_CHECKSTOP, isoData};
+    rasData.getResolution(list.front())->resolve(servData);
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(commitPel(servData));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_CommitPel)->RangeMultiplier(10)->Range(10, 1000);
+
+BENCHMARK_MAIN();
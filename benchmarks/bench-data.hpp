@@ -0,0 +1,41 @@
+#pragma once
+
+#include <analyzer/plugins/plugin.hpp>
+#include <hei_main.hpp>
+#include <hei_util.hpp>
+#include <util/pdbg.hpp>
+
+namespace bench
+{
+
+/**
+ * @brief Builds isolation data containing the given number of recoverable
+ *        signatures from a P10 processor in the simulated system.
+ *
+ * All of the signatures are defined in the RAS data, but none of them have any
+ * flags set. So the root cause filter must walk the entire list in each of its
+ * passes, which is the worst case. EQ_CORE_FIR bits 48-63 meet this criteria
+ * and are defined for all 32 instances. Any list longer than the 512 unique
+ * signatures repeats from the beginning.
+ *
+ * @param i_numSigs The number of signatures.
+ */
+inline libhei::IsolationData getIsoData(size_t i_numSigs)
+{
+    static const auto eqCoreFir = libhei::hash<libhei::NodeId_t>("EQ_CORE_FIR");
+
+    libhei::Chip chip{util::pdbg::getTrgt("/proc0"), analyzer::P10_20};
+
+    libhei::IsolationData isoData{};
+    for (size_t i = 0; i < i_numSigs; i++)
+    {
+        isoData.addSignature(libhei::Signature{
+            chip, eqCoreFir, static_cast<libhei::Instance_t>((i / 16) % 32),
+            static_cast<libhei::BitPosition_t>(48 + i % 16),
+            libhei::ATTN_TYPE_RECOVERABLE});
+    }
+
+    return isoData;
+}
+
+} // namespace bench
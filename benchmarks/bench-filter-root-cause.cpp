@@ -0,0 +1,45 @@
+#include <analyzer/analyzer_main.hpp>
+#include <analyzer/plugins/plugin.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <benchmarks/alloc-counter.hpp>
+#include <benchmarks/bench-data.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace analyzer
+{
+// Forward reference of filterRootCause
+bool filterRootCause(AnalysisType i_type,
+                     const libhei::IsolationData& i_isoData,
+                     libhei::Signature& o_rootCause,
+                     const RasDataParser& i_rasData);
+} // namespace analyzer
+
+using namespace analyzer;
+
+/** @brief A full root cause filter over a list of signatures. */
+static void BM_FilterRootCause(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{{P10_20}};
+
+    auto isoData = bench::getIsoData(state.range(0));
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            libhei::Signature rootCause{};
+            bool found = filterRootCause(AnalysisType::SYSTEM_CHECKSTOP,
+                                         isoData, rootCause, rasData);
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FilterRootCause)->RangeMultiplier(10)->Range(10, 10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+#include <analyzer/plugins/plugin.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <benchmarks/alloc-counter.hpp>
+#include <benchmarks/bench-data.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace analyzer;
+
+/** @brief Construction, which only indexes the RAS data files. */
+static void BM_RasDataParserConstruct(benchmark::State& state)
+{
+    bench::AllocCounter allocs{state};
+
+    for (auto _ : state)
+    {
+        RasDataParser rasData{};
+        benchmark::DoNotOptimize(rasData);
+    }
+}
+BENCHMARK(BM_RasDataParserConstruct);
+
+/** @brief Construction, including loading the RAS data for a P10 chip. */
+static void BM_RasDataParserConstructLoad(benchmark::State& state)
+{
+    bench::AllocCounter allocs{state};
+
+    for (auto _ : state)
+    {
+        RasDataParser rasData{{P10_20}};
+        benchmark::DoNotOptimize(rasData);
+    }
+}
+BENCHMARK(BM_RasDataParserConstructLoad)->Unit(benchmark::kMillisecond);
+
+/** @brief Resolutions for a list of signatures. */
+static void BM_GetResolution(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{{P10_20}};
+
+    auto isoData = bench::getIsoData(state.range(0));
+    const auto& list = isoData.getSignatureList();
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            for (const auto& sig : list)
+            {
+                benchmark::DoNotOptimize(rasData.getResolution(sig));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_GetResolution)->Arg(512);
+
+/** @brief Flag queries for a list of signatures. */
+static void BM_IsFlagSet(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{{P10_20}};
+
+    auto isoData = bench::getIsoData(state.range(0));
+    const auto& list = isoData.getSignatureList();
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            for (const auto& sig : list)
+            {
+                benchmark::DoNotOptimize(
+                    rasData.isFlagSet(sig, RasDataParser::CS_POSSIBLE));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_IsFlagSet)->Arg(512);
+
+BENCHMARK_MAIN();
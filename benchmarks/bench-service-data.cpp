@@ -0,0 +1,79 @@
+#include <analyzer/plugins/plugin.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <analyzer/service_data.hpp>
+#include <benchmarks/alloc-counter.hpp>
+#include <benchmarks/bench-data.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+using namespace analyzer;
+
+/** @brief Resolves the RAS actions of every signature in a list into a single
+ *         ServiceData object, which accumulates (and de-duplicates) the
+ *         callouts and the callout FFDC. */
+static void BM_ServiceDataCallouts(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{{P10_20}};
+
+    auto isoData = std::make_shared<const libhei::IsolationData>(
+        bench::getIsoData(state.range(0)));
+    const auto& list = isoData->getSignatureList();
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            ServiceData servData{list.front(), AnalysisType::SYSTEM_CHECKSTOP,
+                                 isoData};
+
+            for (const auto& sig : list)
+            {
+                rasData.getResolution(sig)->resolve(servData);
+            }
+
+            benchmark::DoNotOptimize(servData.getCalloutList());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_ServiceDataCallouts)->RangeMultiplier(10)->Range(10, 1000);
+
+/** @brief Creates the service data for a list of signatures and walks the
+ *         signature list the same way the plugins do. The isolation data is
+ *         shared with the service data, not copied, so the `allocs` counter
+ *         must not grow with the size of the list. */
+static void BM_ServiceDataIsolationData(benchmark::State& state)
+{
+    pdbg_targets_init(nullptr);
+
+    auto isoData = std::make_shared<const libhei::IsolationData>(
+        bench::getIsoData(state.range(0)));
+    const auto& list = isoData->getSignatureList();
+
+    {
+        bench::AllocCounter allocs{state};
+
+        for (auto _ : state)
+        {
+            ServiceData servData{list.front(), AnalysisType::SYSTEM_CHECKSTOP,
+                                 isoData};
+
+            const auto& sigs = servData.getIsolationData().getSignatureList();
+            benchmark::DoNotOptimize(std::count_if(
+                sigs.begin(), sigs.end(), [](const auto& s) {
+                    return libhei::ATTN_TYPE_RECOVERABLE == s.getAttnType();
+                }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_ServiceDataIsolationData)->RangeMultiplier(10)->Range(10, 10000);
+
+BENCHMARK_MAIN();
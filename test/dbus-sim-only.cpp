@@ -1,17 +1,36 @@
 #include <util/dbus.hpp>
 
+// Using this to fake the value returned from the simulation-only version of
+// util::dbus::getMachineType().
+util::dbus::MachineType g_machineType = util::dbus::MachineType::Rainier_2S4U;
+
 namespace util
 {
 
 namespace dbus
 {
 
+uint32_t createPel(const std::string&, const std::string&,
+                   std::map<std::string, std::string>&,
+                   const std::vector<FFDCTuple>&)
+{
+    // There is no logging service in simulation. The FFDC has already been
+    // collected, so simply return a unique platform log ID.
+    static uint32_t plid = 0x50000000;
+
+    return ++plid;
+}
+
 MachineType getMachineType()
 {
-    // default to Rainier 2S4U
-    MachineType machineType = MachineType::Rainier_2S4U;
+    // Instead of the System IM keyword, use the faked value.
+    return g_machineType;
+}
 
-    return machineType;
+void watchSystemIdentity(sdbusplus::bus_t&)
+{
+    // There are no dbus signals in simulation. The machine type only changes
+    // when a test changes the faked value.
 }
 
 } // namespace dbus
@@ -0,0 +1,88 @@
+#include <endian.h>
+
+#include <hei_main.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+
+namespace analyzer
+{
+// Forward reference of __findChipDataFile
+fs::path __findChipDataFile(libhei::ChipType_t i_chipType,
+                            const fs::path& i_dir, const fs::path& i_indexPath);
+} // namespace analyzer
+
+using namespace analyzer;
+
+/** @brief Writes a chip data file header for the given chip type. */
+void __writeChipData(const fs::path& i_path, libhei::ChipType_t i_chipType)
+{
+    std::ofstream file{i_path, std::ios::binary | std::ios::trunc};
+
+    auto keyword = htobe64(libhei::KW_CHIPDATA);
+    auto chipType = htobe32(i_chipType);
+
+    file.write(reinterpret_cast<const char*>(&keyword), sizeof(keyword));
+    file.write(reinterpret_cast<const char*>(&chipType), sizeof(chipType));
+}
+
+/** @brief Moves the last write time of the given path forward by one second.
+ *         The file system timestamps are too coarse to rely on otherwise. */
+void __touch(const fs::path& i_path)
+{
+    fs::last_write_time(i_path,
+                        fs::last_write_time(i_path) + std::chrono::seconds{1});
+}
+
+TEST(ChipDataIndex, FindFiles)
+{
+    auto root = fs::temp_directory_path() / "openpower-hw-diags-chip-data";
+    fs::remove_all(root);
+
+    auto dir = root / "chip-data";
+    auto indexPath = root / "state" / "chip-data-index";
+    fs::create_directories(dir);
+
+    __writeChipData(dir / "a.cdb", 0x11111111);
+    __writeChipData(dir / "b.cdb", 0x22222222);
+    std::ofstream{dir / "junk"} << "not chip data";
+
+    // The index is built and saved on the first lookup.
+    EXPECT_EQ(dir / "a.cdb", __findChipDataFile(0x11111111, dir, indexPath));
+    EXPECT_EQ(dir / "b.cdb", __findChipDataFile(0x22222222, dir, indexPath));
+    EXPECT_TRUE(__findChipDataFile(0x33333333, dir, indexPath).empty());
+    EXPECT_TRUE(fs::exists(indexPath));
+
+    // A new file changes the directory.
+    __writeChipData(dir / "c.cdb", 0x33333333);
+    __touch(dir);
+    EXPECT_EQ(dir / "c.cdb", __findChipDataFile(0x33333333, dir, indexPath));
+
+    // A file modified in place.
+    __writeChipData(dir / "a.cdb", 0x44444444);
+    __touch(dir / "a.cdb");
+    EXPECT_EQ(dir / "a.cdb", __findChipDataFile(0x44444444, dir, indexPath));
+    EXPECT_TRUE(__findChipDataFile(0x11111111, dir, indexPath).empty());
+
+    // Nothing is rebuilt while the directory and files are unchanged.
+    auto content = [&] {
+        std::ifstream file{indexPath};
+        return std::string{std::istreambuf_iterator<char>{file}, {}};
+    };
+    auto before = content();
+    EXPECT_EQ(dir / "b.cdb", __findChipDataFile(0x22222222, dir, indexPath));
+    EXPECT_EQ(before, content());
+
+    // A corrupted index file is simply rebuilt.
+    std::ofstream{indexPath, std::ios::trunc} << "garbage\n";
+    __touch(dir);
+    EXPECT_EQ(dir / "c.cdb", __findChipDataFile(0x33333333, dir, indexPath));
+    EXPECT_NE("garbage\n", content());
+
+    fs::remove_all(root);
+}
@@ -23,9 +23,9 @@ TEST(ChnlTimeout, MultipleTimeouts)
     libhei::Signature sig1{proc0, dstlfirId, 0, 22, libhei::ATTN_TYPE_UNIT_CS};
     libhei::Signature sig2{proc0, dstlfirId, 0, 23, libhei::ATTN_TYPE_UNIT_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig1);
-    isoData.addSignature(sig2);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig1);
+    isoData->addSignature(sig2);
     ServiceData sd{sig1, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -91,9 +91,9 @@ TEST(ChnlTimeout, DifferentInst)
     libhei::Signature sig1{proc0, dstlfirId, 0, 22, libhei::ATTN_TYPE_UNIT_CS};
     libhei::Signature sig2{proc0, dstlfirId, 1, 22, libhei::ATTN_TYPE_UNIT_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig1);
-    isoData.addSignature(sig2);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig1);
+    isoData->addSignature(sig2);
     ServiceData sd{sig1, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -160,9 +160,9 @@ TEST(ChnlTimeout, DifferentProc)
     libhei::Signature sig1{proc0, dstlfirId, 0, 22, libhei::ATTN_TYPE_UNIT_CS};
     libhei::Signature sig2{proc1, dstlfirId, 0, 22, libhei::ATTN_TYPE_UNIT_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig1);
-    isoData.addSignature(sig2);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig1);
+    isoData->addSignature(sig2);
     ServiceData sd{sig1, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -229,8 +229,8 @@ TEST(ChnlTimeout, SingleTimeout)
 
     libhei::Signature sig1{proc0, dstlfirId, 0, 22, libhei::ATTN_TYPE_UNIT_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig1);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig1);
     ServiceData sd{sig1, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -1,6 +1,12 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <util/bin_stream.hpp>
 #include <util/ffdc_file.hpp>
 #include <util/trace.hpp>
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
 TEST(FFDCFile, TestSet1)
@@ -14,3 +20,62 @@ TEST(FFDCFile, TestSet1)
     std::vector<util::FFDCTuple> tuples;
     ASSERT_NO_THROW(util::transformFFDC(files, tuples));
 }
+
+TEST(FFDCFile, StreamAndSeal)
+{
+    // Pre-size the buffer smaller than the data so that it must be flushed
+    // more than once.
+    std::vector<util::FFDCFile> files;
+    files.emplace_back(util::FFDCFormat::Custom, 1, 1, 8);
+
+    // The file descriptor must remain valid after the vector is resized.
+    files.emplace_back(util::FFDCFormat::Text);
+    auto& file = files.front();
+    int fd = file.getFileDescriptor();
+
+    util::BinFileWriter stream{file.getStream()};
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        stream << i;
+    }
+
+    // Flushes the remaining buffered data.
+    ASSERT_NO_THROW(file.seal());
+    EXPECT_TRUE(stream.good());
+
+    // Sealing again does nothing.
+    ASSERT_NO_THROW(file.seal());
+
+    // The file is rewound and contains all of the data.
+    EXPECT_EQ(0, lseek(fd, 0, SEEK_CUR));
+    EXPECT_EQ(5000 * sizeof(uint32_t), lseek(fd, 0, SEEK_END));
+
+    uint32_t data = 0;
+    EXPECT_EQ(sizeof(data), pread(fd, &data, sizeof(data), 4999 * 4));
+    EXPECT_EQ(4999u, be32toh(data));
+
+    // The file can no longer be changed.
+    int seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+    EXPECT_EQ(seals, fcntl(fd, F_GET_SEALS));
+    EXPECT_EQ(-1, pwrite(fd, &data, sizeof(data), 0));
+    EXPECT_EQ(-1, ftruncate(fd, 0));
+}
+
+TEST(FFDCFile, DirectWrite)
+{
+    util::FFDCFile file{util::FFDCFormat::Text};
+    int fd = file.getFileDescriptor();
+
+    const char text[] = "hello";
+    ASSERT_EQ(5, write(fd, text, 5));
+
+    // Sealing rewinds the file so it can be read from the beginning.
+    ASSERT_NO_THROW(file.seal());
+
+    char buffer[8] = {};
+    EXPECT_EQ(5, read(fd, buffer, sizeof(buffer)));
+    EXPECT_STREQ(text, buffer);
+
+    ASSERT_NO_THROW(file.remove());
+    EXPECT_EQ(-1, file.getFileDescriptor());
+}
@@ -25,7 +25,7 @@ TEST(LpcTimeout, TestSet1)
     auto plugin = PluginMap::getSingleton().get(chip.getType(), "lpc_timeout");
 
     ServiceData sd{libhei::Signature{}, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     plugin(0, chip, sd);
 
@@ -66,7 +66,7 @@ TEST(LpcTimeout, TestSet2)
     auto plugin = PluginMap::getSingleton().get(chip.getType(), "lpc_timeout");
 
     ServiceData sd{libhei::Signature{}, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     plugin(0, chip, sd);
 
@@ -0,0 +1,38 @@
+#include <analyzer/node_id.hpp>
+#include <hei_util.hpp>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace analyzer;
+
+// The node IDs must be computed at compile time.
+static_assert(0x682c == "EQ_CORE_FIR"_node);
+static_assert(0 == ""_node);
+static_assert(nodeId("PLL_UNLOCK") == "PLL_UNLOCK"_node);
+
+TEST(NodeId, MatchesLibheiHash)
+{
+    // All of the node names used by the analyzer code, plus a few edge cases
+    // (empty, single character, and odd lengths that require padding).
+    std::vector<std::string> names{
+        "PLL_UNLOCK", "MC_DSTL_FIR", "MC_USTL_FIR", "MC_OMI_DL_ERR_RPT",
+        "TP_LOCAL_FIR", "TOD_ERROR", "PB_EXT_FIR", "EQ_CORE_FIR", "RDFFIR",
+        "RDF_FIR", "SRQFIR", "SRQ_FIR", "", "A", "ABC", "N1_LOCAL_FIR_X"};
+
+    for (const auto& name : names)
+    {
+        EXPECT_EQ(libhei::hash<libhei::NodeId_t>(name), nodeId(name)) << name;
+    }
+
+    // The literal must match the runtime hash as well.
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("PLL_UNLOCK"), "PLL_UNLOCK"_node);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("MC_DSTL_FIR"),
+              "MC_DSTL_FIR"_node);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("RDFFIR"), "RDFFIR"_node);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("RDF_FIR"), "RDF_FIR"_node);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("SRQFIR"), "SRQFIR"_node);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("SRQ_FIR"), "SRQ_FIR"_node);
+}
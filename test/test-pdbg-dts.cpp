@@ -164,6 +164,22 @@ TEST(util_pdbg, getChipUnit)
     // Get the unit and verify.
     EXPECT_EQ(memPortUnit,
               getChipUnit(ocmbChip, TYPE_MEM_PORT, memPortUnitPos));
+
+    // Every unit found in the index must match the devtree, including on
+    // repeated lookups.
+    for (auto [type, cls] : {std::pair{TYPE_CORE, "core"},
+                             std::pair{TYPE_OMI, "omi"},
+                             std::pair{TYPE_IOHS, "iohs"}})
+    {
+        pdbg_target* unit;
+        pdbg_for_each_target(cls, procChip, unit)
+        {
+            for (int i = 0; i < 2; i++)
+            {
+                EXPECT_EQ(unit, getChipUnit(procChip, type, getUnitPos(unit)));
+            }
+        }
+    }
 }
 
 TEST(util_pdbg, getScom)
@@ -235,6 +251,176 @@ TEST(util_pdbg, getCfam)
     EXPECT_DEATH({ getCfam(omiUnit, 0x11111111, val); }, "");
 }
 
+TEST(util_pdbg, ScopedRegisterCache)
+{
+    using namespace util::pdbg;
+    pdbg_targets_init(nullptr);
+
+    auto proc0 = getTrgt("/proc0");
+    auto proc1 = getTrgt("/proc1");
+
+    sim::ScomAccess& scom = sim::ScomAccess::getSingleton();
+    scom.flush();
+    scom.add(proc0, 0x11111111, 0x0011223344556677);
+    scom.add(proc1, 0x11111111, 0x8899aabbccddeeff);
+    scom.error(proc0, 0x22222222);
+
+    sim::CfamAccess& cfam = sim::CfamAccess::getSingleton();
+    cfam.flush();
+    cfam.add(proc0, 0x11111111, 0x00112233);
+
+    uint64_t val = 0;
+    uint32_t cfamVal = 0;
+
+    {
+        ScopedRegisterCache cache{};
+
+        // The first read of each register goes to hardware.
+        EXPECT_EQ(0, getScom(proc0, 0x11111111, val));
+        EXPECT_EQ(0x0011223344556677, val);
+        EXPECT_EQ(0, getScom(proc1, 0x11111111, val));
+        EXPECT_EQ(0x8899aabbccddeeff, val);
+        EXPECT_EQ(0, getCfam(proc0, 0x11111111, cfamVal));
+        EXPECT_EQ(0x00112233, cfamVal);
+
+        // Any further reads come from the cache.
+        scom.add(proc0, 0x11111111, 0);
+        cfam.add(proc0, 0x11111111, 0);
+        EXPECT_EQ(0, getScom(proc0, 0x11111111, val));
+        EXPECT_EQ(0x0011223344556677, val);
+        EXPECT_EQ(0, getCfam(proc0, 0x11111111, cfamVal));
+        EXPECT_EQ(0x00112233, cfamVal);
+
+        // Failed reads are not cached.
+        EXPECT_EQ(1, getScom(proc0, 0x22222222, val));
+        EXPECT_EQ(1, getScom(proc0, 0x22222222, val));
+
+        // Invalidate a single target.
+        scom.add(proc1, 0x11111111, 0);
+        ScopedRegisterCache::invalidate(proc1);
+        EXPECT_EQ(0, getScom(proc0, 0x11111111, val));
+        EXPECT_EQ(0x0011223344556677, val);
+        EXPECT_EQ(0, getScom(proc1, 0x11111111, val));
+        EXPECT_EQ(0, val);
+
+        // Invalidate everything.
+        ScopedRegisterCache::invalidate();
+        EXPECT_EQ(0, getScom(proc0, 0x11111111, val));
+        EXPECT_EQ(0, val);
+
+        auto entries = cache.getEntries();
+        EXPECT_EQ(4, entries.size());
+
+        using Space = ScopedRegisterCache::Space;
+
+        const auto& scom0 = entries.at({proc0, Space::SCOM, 0x11111111});
+        EXPECT_EQ(2, scom0.hits);
+        EXPECT_EQ(2, scom0.misses);
+
+        const auto& scom1 = entries.at({proc1, Space::SCOM, 0x11111111});
+        EXPECT_EQ(0, scom1.hits);
+        EXPECT_EQ(2, scom1.misses);
+
+        const auto& error = entries.at({proc0, Space::SCOM, 0x22222222});
+        EXPECT_EQ(0, error.hits);
+        EXPECT_EQ(2, error.misses);
+        EXPECT_FALSE(error.value);
+
+        const auto& cfam0 = entries.at({proc0, Space::CFAM, 0x11111111});
+        EXPECT_EQ(1, cfam0.hits);
+        EXPECT_EQ(1, cfam0.misses);
+
+        cache.traceCounters();
+    }
+
+    // Nothing is cached outside of the scope.
+    scom.add(proc1, 0x11111111, 0x8899aabbccddeeff);
+    EXPECT_EQ(0, getScom(proc1, 0x11111111, val));
+    EXPECT_EQ(0x8899aabbccddeeff, val);
+}
+
+TEST(util_pdbg, TargetAttributes)
+{
+    using namespace util::pdbg;
+    pdbg_targets_init(nullptr);
+
+    // The cached attributes must match the device tree, including on repeated
+    // lookups.
+    for (auto cls : {"proc", "ocmb", "mcc", "omi", "core", "mem_port"})
+    {
+        pdbg_target* trgt;
+        pdbg_for_each_class_target(cls, trgt)
+        {
+            uint8_t type = 0;
+            uint32_t chipPos = 0;
+            uint8_t unitPos = 0;
+            pdbg_target_get_attribute(trgt, "ATTR_TYPE", 1, 1, &type);
+            pdbg_target_get_attribute(trgt, "ATTR_FAPI_POS", 4, 1, &chipPos);
+            pdbg_target_get_attribute(trgt, "ATTR_CHIP_UNIT_POS", 1, 1,
+                                      &unitPos);
+
+            for (int i = 0; i < 2; i++)
+            {
+                EXPECT_EQ(type, getTrgtType(trgt));
+                EXPECT_EQ(chipPos, getChipPos(trgt));
+                EXPECT_EQ(unitPos, getUnitPos(trgt));
+            }
+        }
+    }
+
+    auto proc1 = getTrgt("/proc1");
+    EXPECT_EQ(getTrgt("/proc1/pib"), getPibTrgt(proc1));
+    EXPECT_EQ(getTrgt("/proc1/fsi"), getFsiTrgt(proc1));
+    EXPECT_EQ(proc1, getParentChip(proc1));
+
+    auto omi = getTrgt("/proc0/pib/perv13/mc1/mi0/mcc0/omi1");
+    auto ocmb = getTrgt("/proc0/pib/perv13/mc1/mi0/mcc0/omi1/ocmb0");
+    auto memPort =
+        getTrgt("/proc0/pib/perv13/mc1/mi0/mcc0/omi1/ocmb0/mem_port0");
+    EXPECT_EQ(getTrgt("/proc0"), getParentChip(omi));
+    EXPECT_EQ(ocmb, getParentChip(ocmb));
+    EXPECT_EQ(ocmb, getParentChip(memPort));
+}
+
+TEST(util_pdbg, ProcTopology)
+{
+    using namespace util::pdbg;
+    pdbg_targets_init(nullptr);
+
+    // Every processor in the device tree is in the topology, in order.
+    std::vector<pdbg_target*> procs;
+    pdbg_target* trgt;
+    pdbg_for_each_class_target("proc", trgt)
+    {
+        procs.push_back(trgt);
+    }
+
+    const auto& topology = getProcTopology();
+    ASSERT_EQ(procs.size(), topology.size());
+
+    for (size_t i = 0; i < procs.size(); i++)
+    {
+        const auto& entry = topology[i];
+        auto idx = pdbg_target_index(procs[i]);
+
+        EXPECT_EQ(procs[i], entry.proc);
+        EXPECT_EQ(idx, entry.index);
+        EXPECT_EQ(getTrgt("/proc" + std::to_string(idx) + "/pib"), entry.pib);
+        EXPECT_EQ(getTrgt("/proc" + std::to_string(idx) + "/fsi"), entry.fsi);
+        EXPECT_EQ(PDBG_TARGET_ENABLED == pdbg_target_probe(entry.pib),
+                  entry.enabled);
+
+        EXPECT_EQ(&entry, getProcTargets(procs[i]));
+        EXPECT_EQ(&entry, getProcTargetsByIndex(idx));
+    }
+
+    // The topology is only built once.
+    EXPECT_EQ(&topology, &getProcTopology());
+
+    EXPECT_EQ(nullptr, getProcTargetsByIndex(99));
+    EXPECT_EQ(nullptr, getProcTargets(getTrgt("/proc0/pib")));
+}
+
 TEST(util_pdbg, getActiveChips)
 {
     using namespace util::pdbg;
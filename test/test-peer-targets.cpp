@@ -0,0 +1,115 @@
+#include <libpdbg.h>
+
+#include <analyzer/callout.hpp>
+#include <nlohmann/json.hpp>
+#include <util/data_file.hpp>
+#include <util/dbus.hpp>
+#include <util/mapped_file.hpp>
+#include <util/pdbg.hpp>
+#include <util/peer_targets.hpp>
+#include <util/trace.hpp>
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+
+using namespace util::peer_targets;
+
+extern util::dbus::MachineType g_machineType;
+
+TEST(PeerTargets, CrossCheck)
+{
+    fs::path dataDir{PACKAGE_DIR "util-data"};
+    std::vector<fs::path> dataPaths;
+    util::findFiles(dataDir, R"(peer-targets-.*\.json)", dataPaths);
+    ASSERT_FALSE(dataPaths.empty());
+
+    for (const auto& path : dataPaths)
+    {
+        trace::inf("Cross-checking: %s", path.string().c_str());
+
+        std::ifstream file{path};
+        ASSERT_TRUE(file.good());
+        auto data = nlohmann::json::parse(file).get<util::PeerTargetMap>();
+
+        // Each JSON data file must have a compiled image with the same
+        // contents.
+        util::MappedFile image{fs::path{path}.replace_extension(".bin")};
+        EXPECT_EQ(data, util::parsePeerTargetImage({image.data(),
+                                                    image.size()}));
+
+        EXPECT_EQ(data, util::readPeerTargets(path));
+    }
+}
+
+TEST(PeerTargets, InvalidImage)
+{
+    // Too small for the header.
+    uint8_t small[sizeof(Header) - 1] = {};
+    EXPECT_THROW(util::parsePeerTargetImage(small), std::runtime_error);
+
+    // Bad magic.
+    Header header{};
+    auto bytes = reinterpret_cast<const uint8_t*>(&header);
+    EXPECT_THROW(util::parsePeerTargetImage({bytes, sizeof(header)}),
+                 std::runtime_error);
+
+    // Entries extend beyond the end of the image.
+    header.magic = MAGIC;
+    header.formatVersion = FORMAT_VERSION;
+    header.entries = 1;
+    EXPECT_THROW(util::parsePeerTargetImage({bytes, sizeof(header)}),
+                 std::runtime_error);
+
+    // Missing string table.
+    header.entries = 0;
+    EXPECT_THROW(util::parsePeerTargetImage({bytes, sizeof(header)}),
+                 std::runtime_error);
+
+    // Unsupported format.
+    header.formatVersion = FORMAT_VERSION + 1;
+    EXPECT_THROW(util::parsePeerTargetImage({bytes, sizeof(header)}),
+                 std::runtime_error);
+}
+
+TEST(PeerTargets, getConnectedTarget)
+{
+    using namespace util::pdbg;
+    using analyzer::callout::BusType;
+    pdbg_targets_init(nullptr);
+
+    // The simulated machine type is Rainier 4U.
+    auto rx = getTrgt("/proc0/pib/perv26/pauc1/iohs0/smpgroup0");
+    auto tx = getTrgt("/proc1/pib/perv25/pauc0/iohs1/smpgroup0");
+
+    // Repeated lookups must return the same peer.
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(tx, getConnectedTarget(rx, BusType::SMP_BUS));
+        EXPECT_EQ(rx, getConnectedTarget(tx, BusType::SMP_BUS));
+    }
+}
+
+TEST(PeerTargets, MachineTypeChange)
+{
+    using namespace util::pdbg;
+    using analyzer::callout::BusType;
+    using util::dbus::MachineType;
+    pdbg_targets_init(nullptr);
+
+    // This bus is only connected on Rainier.
+    auto rx = getTrgt("/proc0/pib/perv28/pauc2/iohs0/smpgroup0");
+    auto tx = getTrgt("/proc2/pib/perv31/pauc3/iohs1/smpgroup0");
+
+    g_machineType = MachineType::Rainier_2S4U;
+    EXPECT_EQ(tx, getConnectedTarget(rx, BusType::SMP_BUS));
+
+    // The peer targets are reloaded when the machine type changes.
+    g_machineType = MachineType::Bonnell;
+    EXPECT_NE(tx, getConnectedTarget(rx, BusType::SMP_BUS));
+
+    g_machineType = MachineType::Rainier_2S4U;
+    EXPECT_EQ(tx, getConnectedTarget(rx, BusType::SMP_BUS));
+}
@@ -31,8 +31,8 @@ TEST(PllUnlock, TestSet1)
 
     libhei::Signature sig11{chip1, nodeId, 0, 1, libhei::ATTN_TYPE_CHIP_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig11);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig11);
     ServiceData sd{sig11, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -97,11 +97,11 @@ TEST(PllUnlock, TestSet2)
     // Plugins for each processor.
     auto plugin = PluginMap::getSingleton().get(chip1.getType(), "pll_unlock");
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig00);
-    isoData.addSignature(sig01);
-    isoData.addSignature(sig10);
-    isoData.addSignature(sig11);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig00);
+    isoData->addSignature(sig01);
+    isoData->addSignature(sig10);
+    isoData->addSignature(sig11);
     ServiceData sd{sig10, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     // Call the PLL unlock plugin.
@@ -169,8 +169,8 @@ TEST(PllUnlock, TestSet3)
 
     libhei::Signature sig{ocmb0, nodeId, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig);
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -234,9 +234,9 @@ TEST(PllUnlock, TestSet4)
     libhei::Signature sig0{ocmb0, nodeId, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
     libhei::Signature sig1{ocmb1, nodeId, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig0);
-    isoData.addSignature(sig1);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig0);
+    isoData->addSignature(sig1);
     ServiceData sd{sig0, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
@@ -312,9 +312,9 @@ TEST(PllUnlock, TestSet5)
     libhei::Signature sig0{ocmb0, nodeId, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
     libhei::Signature sig1{ocmb1, nodeId, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig0);
-    isoData.addSignature(sig1);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig0);
+    isoData->addSignature(sig1);
     ServiceData sd{sig0, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     RasDataParser rasData{};
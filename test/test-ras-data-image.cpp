@@ -0,0 +1,567 @@
+#include <analyzer/analyzer_main.hpp>
+#include <analyzer/ras-data/ras-data-builtin.hpp>
+#include <analyzer/ras-data/ras-data-image.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <hei_util.hpp>
+#include <util/data_file.hpp>
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fs = std::filesystem;
+
+using namespace analyzer;
+using namespace analyzer::ras_data_image;
+
+using RDF = RasDataParser::RasDataFlags;
+
+// clang-format off
+const std::map<std::string, unsigned int> flagBits =
+{
+    {"sue_source",                   RDF::SUE_SOURCE},
+    {"sue_seen",                     RDF::SUE_SEEN},
+    {"cs_possible",                  RDF::CS_POSSIBLE},
+    {"recovered_error",              RDF::RECOVERED_ERROR},
+    {"informational_only",           RDF::INFORMATIONAL_ONLY},
+    {"mnfg_informational_only",      RDF::MNFG_INFORMATIONAL_ONLY},
+    {"mask_but_dont_clear",          RDF::MASK_BUT_DONT_CLEAR},
+    {"crc_related_err",              RDF::CRC_RELATED_ERR},
+    {"crc_root_cause",               RDF::CRC_ROOT_CAUSE},
+    {"odp_data_corrupt_side_effect", RDF::ODP_DATA_CORRUPT_SIDE_EFFECT},
+    {"odp_data_corrupt_root_cause",  RDF::ODP_DATA_CORRUPT_ROOT_CAUSE},
+    {"attn_from_ocmb",               RDF::ATTN_FROM_OCMB},
+    {"external_checkstop",           12},
+};
+
+const std::vector<std::string> elementTypes =
+{
+    "action", "callout_self", "callout_unit", "callout_connected",
+    "callout_bus", "callout_clock", "callout_procedure", "callout_part",
+    "plugin", "flag",
+};
+
+const std::vector<std::string> priorities =
+{
+    "HIGH", "MED", "MED_A", "MED_B", "MED_C", "LOW",
+};
+
+const std::vector<std::string> clocks =
+{
+    "OSC_REF_CLOCK_0", "OSC_REF_CLOCK_1", "TOD_CLOCK",
+};
+
+const std::vector<std::string> procedures = {"LEVEL2", "SUE_SEEN"};
+
+const std::vector<std::string> parts = {"PNOR"};
+
+const std::vector<std::string> busTypes = {"SMP_BUS", "OMI_BUS"};
+
+const std::map<std::string, unsigned int> attnTypes =
+{
+    {"CHIP_CS",     libhei::ATTN_TYPE_CHIP_CS},
+    {"UNIT_CS",     libhei::ATTN_TYPE_UNIT_CS},
+    {"RECOVERABLE", libhei::ATTN_TYPE_RECOVERABLE},
+    {"SP_ATTN",     libhei::ATTN_TYPE_SP_ATTN},
+    {"HOST_ATTN",   libhei::ATTN_TYPE_HOST_ATTN},
+};
+
+const std::map<std::string, unsigned int> analysisTypes =
+{
+    {"SYSTEM_CHECKSTOP",    unsigned(AnalysisType::SYSTEM_CHECKSTOP)},
+    {"TERMINATE_IMMEDIATE", unsigned(AnalysisType::TERMINATE_IMMEDIATE)},
+    {"MANUAL",              unsigned(AnalysisType::MANUAL)},
+};
+// clang-format on
+
+unsigned int __index(const std::vector<std::string>& i_list,
+                     const std::string& i_name)
+{
+    auto itr = std::find(i_list.begin(), i_list.end(), i_name);
+    EXPECT_NE(i_list.end(), itr) << i_name;
+    return itr - i_list.begin();
+}
+
+uint32_t __mask(const nlohmann::json& i_rule, const std::string& i_key,
+                const std::map<std::string, unsigned int>& i_bits)
+{
+    uint32_t mask = 0;
+    if (!i_rule.contains(i_key))
+    {
+        for (const auto& [name, bit] : i_bits)
+        {
+            mask |= 1u << bit;
+        }
+    }
+    else
+    {
+        for (const auto& name : i_rule.at(i_key))
+        {
+            mask |= 1u << i_bits.at(name.get<std::string>());
+        }
+    }
+    return mask;
+}
+
+// Verifies the compiled filter rules match the JSON data. Each rule with
+// multiple nodes is expanded into one entry per node.
+void __crossCheckFilterRules(const nlohmann::json& i_data,
+                             const RasDataImage& i_image)
+{
+    // The filter rules are required.
+    ASSERT_TRUE(i_data.contains("filter_rules"));
+
+    const auto& section = i_data.at("filter_rules");
+    EXPECT_EQ(section.at("version").get<unsigned int>(),
+              i_image.getFilterRulesVersion());
+
+    struct Expected
+    {
+        const nlohmann::json* rule;
+        NodeMatch nodeMatch;
+        std::string node;
+    };
+
+    std::vector<Expected> expected;
+    for (const auto& r : section.at("rules"))
+    {
+        if (r.contains("nodes"))
+        {
+            for (const auto& n : r.at("nodes"))
+            {
+                expected.push_back({&r, NodeMatch::EQUAL, n});
+            }
+        }
+        else if (r.contains("exclude_node"))
+        {
+            expected.push_back({&r, NodeMatch::NOT_EQUAL, r["exclude_node"]});
+        }
+        else
+        {
+            expected.push_back({&r, NodeMatch::ANY, ""});
+        }
+    }
+
+    std::ranges::stable_sort(expected, {}, [](const auto& e) {
+        return e.rule->at("rank").template get<unsigned int>();
+    });
+
+    auto entries = i_image.getFilterRules();
+    ASSERT_EQ(expected.size(), entries.size());
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const auto& r = *expected[i].rule;
+        const auto& x = entries[i];
+
+        EXPECT_EQ(r.at("rank").get<unsigned int>(), x.rank);
+        EXPECT_EQ(expected[i].nodeMatch, x.nodeMatch);
+        if (NodeMatch::ANY != x.nodeMatch)
+        {
+            EXPECT_EQ(libhei::hash<libhei::NodeId_t>(expected[i].node), x.node);
+        }
+
+        uint64_t bits = ~uint64_t{0};
+        if (r.contains("bits"))
+        {
+            bits = 0;
+            for (const auto& b : r.at("bits"))
+            {
+                bits |= uint64_t{1} << b.get<unsigned int>();
+            }
+        }
+        EXPECT_EQ(bits, uint64_t{x.bits[1]} << 32 | x.bits[0]);
+
+        EXPECT_EQ(__mask(r, "attn_types", attnTypes), x.attnTypes);
+        EXPECT_EQ(__mask(r, "analysis_types", analysisTypes), x.analysisTypes);
+
+        // Unlike the other masks, no flags are set by default.
+        for (auto [key, mask] : {std::pair{"any_flags", x.anyFlags},
+                                 std::pair{"no_flags", x.noFlags}})
+        {
+            EXPECT_EQ(r.contains(key) ? __mask(r, key, flagBits) : 0, mask);
+        }
+
+        EXPECT_EQ(r.value("no_ocmb_attns", false),
+                  0 != (x.conditions & NO_OCMB_ATTNS));
+    }
+}
+
+// Verifies the compiled image has the exact same content as the JSON data.
+void __crossCheck(const nlohmann::json& i_data, const RasDataImage& i_image)
+{
+    libhei::ChipType_t chipType =
+        std::stoul(i_data.at("model_ec").get<std::string>(), nullptr, 16);
+    EXPECT_EQ(chipType, i_image.getChipType());
+
+    EXPECT_EQ(i_data.at("version").get<unsigned int>(), i_image.getVersion());
+
+    auto defaultAction = i_image.getDefaultAction();
+    if (i_data.at("actions").contains("level2_M_th1"))
+    {
+        ASSERT_NE(NONE, defaultAction);
+        EXPECT_EQ("level2_M_th1", i_image.getActionName(defaultAction));
+    }
+    else
+    {
+        EXPECT_EQ(NONE, defaultAction);
+    }
+
+    libhei::Chip chip{nullptr, chipType};
+
+    // Signatures and flags
+    for (const auto& [id, bits] : i_data.at("signatures").items())
+    {
+        for (const auto& [bit, insts] : bits.items())
+        {
+            uint32_t flags = 0;
+            if (insts.contains("flags"))
+            {
+                for (const auto& f : insts.at("flags"))
+                {
+                    flags |= 1u << flagBits.at(f.get<std::string>());
+                }
+            }
+
+            for (const auto& [inst, action] : insts.items())
+            {
+                if ("flags" == inst)
+                {
+                    continue;
+                }
+
+                auto sigId = std::stoul(id, nullptr, 16);
+                auto sigInst = std::stoul(inst, nullptr, 16);
+                auto sigBit = std::stoul(bit, nullptr, 16);
+
+                libhei::Signature sig{chip, libhei::NodeId_t(sigId),
+                                      libhei::Instance_t(sigInst),
+                                      libhei::BitPosition_t(sigBit),
+                                      libhei::ATTN_TYPE_CHIP_CS};
+
+                auto idx = i_image.getSignatureAction(sig);
+                ASSERT_NE(NONE, idx) << id << " " << bit << " " << inst;
+                EXPECT_EQ(action.get<std::string>(),
+                          i_image.getActionName(idx));
+
+                EXPECT_EQ(flags, i_image.getSignatureFlags(sig));
+            }
+        }
+    }
+
+    // Actions
+    const auto& units = i_data.value("units", nlohmann::json::object());
+    const auto& buses = i_data.value("buses", nlohmann::json::object());
+
+    EXPECT_EQ(i_data.at("actions").size(), i_image.getNumActions());
+
+    for (const auto& [name, elements] : i_data.at("actions").items())
+    {
+        auto idx = i_image.findAction(name);
+        ASSERT_NE(NONE, idx) << name;
+        EXPECT_EQ(name, i_image.getActionName(idx));
+
+        auto entries = i_image.getActionElements(idx);
+        ASSERT_EQ(elements.size(), entries.size()) << name;
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            const auto& e = elements.at(i);
+            const auto& x = entries[i];
+
+            auto type = e.at("type").get<std::string>();
+            EXPECT_EQ(__index(elementTypes, type), unsigned(x.type));
+
+            if (e.contains("priority"))
+            {
+                EXPECT_EQ(__index(priorities, e.at("priority")), x.priority);
+            }
+
+            EXPECT_EQ(e.value("guard", false), 0 != x.guard);
+
+            if ("action" == type)
+            {
+                EXPECT_EQ(e.at("name").get<std::string>(),
+                          i_image.getActionName(x.arg0));
+            }
+            else if ("callout_unit" == type)
+            {
+                auto unit = e.at("name").get<std::string>();
+                const auto& u = i_image.getUnit(x.arg0);
+                EXPECT_EQ(unit, i_image.getString(u.name));
+                EXPECT_EQ(units.at(unit).get<std::string>(),
+                          i_image.getString(u.path));
+            }
+            else if ("callout_connected" == type || "callout_bus" == type)
+            {
+                auto bus = e.at("name").get<std::string>();
+                const auto& b = i_image.getBus(x.arg0);
+                EXPECT_EQ(bus, i_image.getString(b.name));
+                EXPECT_EQ(__index(busTypes, buses.at(bus).at("type")), b.type);
+                if (buses.at(bus).contains("unit"))
+                {
+                    ASSERT_NE(NONE, b.unit);
+                    auto unit = buses.at(bus).at("unit").get<std::string>();
+                    EXPECT_EQ(units.at(unit).get<std::string>(),
+                              i_image.getString(i_image.getUnit(b.unit).path));
+                }
+                else
+                {
+                    EXPECT_EQ(NONE, b.unit);
+                }
+            }
+            else if ("callout_clock" == type)
+            {
+                EXPECT_EQ(__index(clocks, e.at("name")), x.arg0);
+            }
+            else if ("callout_procedure" == type)
+            {
+                EXPECT_EQ(__index(procedures, e.at("name")), x.arg0);
+            }
+            else if ("callout_part" == type)
+            {
+                EXPECT_EQ(__index(parts, e.at("name")), x.arg0);
+            }
+            else if ("plugin" == type)
+            {
+                EXPECT_EQ(e.at("name").get<std::string>(),
+                          i_image.getString(x.arg0));
+                EXPECT_EQ(e.at("instance").get<unsigned int>(), x.arg1);
+            }
+            else if ("flag" == type)
+            {
+                EXPECT_EQ(flagBits.at(e.at("name")), x.arg0);
+            }
+        }
+    }
+
+    __crossCheckFilterRules(i_data, i_image);
+}
+
+/**
+ * @return The compiled RAS data images. The images are only installed when the
+ *         RAS data is loaded from the data files at runtime. Otherwise, they
+ *         are built into the program.
+ */
+std::vector<RasDataImage> __getImages()
+{
+    std::vector<RasDataImage> images;
+
+    for (const auto& data : getBuiltinRasData())
+    {
+        images.emplace_back(data);
+    }
+
+    if (images.empty())
+    {
+        fs::path dataDir{PACKAGE_DIR "ras-data"};
+        std::vector<fs::path> imagePaths;
+        util::findFiles(dataDir, R"(.*\.bin)", imagePaths);
+
+        for (const auto& path : imagePaths)
+        {
+            images.emplace_back(path);
+        }
+    }
+
+    return images;
+}
+
+TEST(RasDataImage, CrossCheck)
+{
+    fs::path dataDir{PACKAGE_DIR "ras-data"};
+    std::vector<fs::path> dataPaths;
+    util::findFiles(dataDir, R"(.*\.json)", dataPaths);
+    ASSERT_FALSE(dataPaths.empty());
+
+    // Each JSON data file must have exactly one compiled image.
+    auto images = __getImages();
+    ASSERT_EQ(dataPaths.size(), images.size());
+
+    for (const auto& path : dataPaths)
+    {
+        trace::inf("Cross-checking: %s", path.string().c_str());
+
+        std::ifstream file{path};
+        ASSERT_TRUE(file.good());
+        auto data = nlohmann::json::parse(file);
+
+        auto chipType =
+            std::stoul(data.at("model_ec").get<std::string>(), nullptr, 16);
+
+        auto itr = std::find_if(images.begin(), images.end(), [&](auto& i) {
+            return chipType == i.getChipType();
+        });
+        ASSERT_NE(images.end(), itr) << path;
+
+        __crossCheck(data, *itr);
+    }
+}
+
+TEST(RasDataImage, Builtin)
+{
+    auto builtin = getBuiltinRasData();
+    if (builtin.empty())
+    {
+        GTEST_SKIP() << "RAS data is not built into the program";
+    }
+
+    // There must be only one built-in image per chip type. The contents are
+    // cross-checked against the data files above.
+    std::set<libhei::ChipType_t> chipTypes;
+    for (const auto& data : builtin)
+    {
+        EXPECT_TRUE(chipTypes.insert(RasDataImage{data}.getChipType()).second);
+    }
+}
+
+TEST(RasDataImage, UndefinedSignature)
+{
+    auto images = __getImages();
+    ASSERT_FALSE(images.empty());
+
+    const auto& image = images.front();
+
+    libhei::Chip chip{nullptr, image.getChipType()};
+    libhei::Signature sig{chip, 0x0000, 0xff, 0xff, libhei::ATTN_TYPE_CHIP_CS};
+
+    EXPECT_EQ(NONE, image.getSignatureAction(sig));
+    EXPECT_EQ(0u, image.getSignatureFlags(sig));
+    EXPECT_EQ(NONE, image.findAction("not_an_action"));
+}
+
+TEST(RasDataImage, InvalidImage)
+{
+    // Too small for the header.
+    alignas(Header) uint8_t small[sizeof(Header) - 1] = {};
+    EXPECT_THROW(RasDataImage{std::span<const uint8_t>{small}},
+                 std::runtime_error);
+
+    // Bad magic.
+    Header header{};
+    auto bytes = reinterpret_cast<const uint8_t*>(&header);
+    EXPECT_THROW((RasDataImage{std::span{bytes, sizeof(header)}}),
+                 std::runtime_error);
+
+    // Tables extend beyond the end of the image.
+    header.magic = MAGIC;
+    header.formatVersion = FORMAT_VERSION;
+    header.signatures = 1;
+    EXPECT_THROW((RasDataImage{std::span{bytes, sizeof(header)}}),
+                 std::runtime_error);
+
+    // Missing string table.
+    header.signatures = 0;
+    EXPECT_THROW((RasDataImage{std::span{bytes, sizeof(header)}}),
+                 std::runtime_error);
+
+    // Unsupported format.
+    header.formatVersion = FORMAT_VERSION + 1;
+    EXPECT_THROW((RasDataImage{std::span{bytes, sizeof(header)}}),
+                 std::runtime_error);
+}
+
+TEST(RasDataParser, OnDemandLoading)
+{
+    libhei::Chip p10{nullptr, 0x20da0020};
+    libhei::Chip explorer{nullptr, 0x60d20020};
+    libhei::Chip unknown{nullptr, 0xdeadbeef};
+
+    libhei::Signature p10Sig{p10, 0x0000, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
+    libhei::Signature expSig{explorer, 0x0000, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
+    libhei::Signature badSig{unknown, 0x0000, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
+
+    // Only P10 is loaded up front. Explorer is loaded when first used.
+    RasDataParser rasData{{p10.getType()}};
+
+    EXPECT_EQ(2u, rasData.getVersion(p10Sig));
+    EXPECT_EQ(2u, rasData.getVersion(expSig));
+
+    // There is no RAS data for this chip type.
+    EXPECT_THROW(rasData.getVersion(badSig), std::out_of_range);
+}
+
+TEST(RasDataParser, InheritedFlags)
+{
+    libhei::Chip p10{nullptr, 0x20da0020};
+
+    RasDataParser rasData{{p10.getType()}};
+
+    // EQ_CORE_FIR[0] has the flag defined directly on the signature.
+    libhei::Signature sig1{p10, 0x682c, 0, 0, libhei::ATTN_TYPE_RECOVERABLE};
+    EXPECT_TRUE(rasData.isFlagSet(sig1, RDF::CS_POSSIBLE));
+    EXPECT_FALSE(rasData.isFlagSet(sig1, RDF::ATTN_FROM_OCMB));
+
+    // This signature inherits the flag from its action (self_M_th_32perDay).
+    libhei::Signature sig2{p10, 0x06b6, 0, 9, libhei::ATTN_TYPE_RECOVERABLE};
+    EXPECT_TRUE(rasData.isFlagSet(sig2, RDF::RECOVERED_ERROR));
+    EXPECT_FALSE(rasData.isFlagSet(sig2, RDF::CS_POSSIBLE));
+
+    // Signatures not defined in the RAS data use the default action.
+    libhei::Signature sig3{p10, 0x0000, 0xff, 0xff, libhei::ATTN_TYPE_CHIP_CS};
+    EXPECT_FALSE(rasData.isFlagSet(sig3, RDF::RECOVERED_ERROR));
+}
+
+TEST(RasDataParser, SharedResolutions)
+{
+    libhei::Chip p10{nullptr, 0x20da0020};
+
+    RasDataParser rasData{{p10.getType()}};
+
+    // EQ_CORE_FIR[1] and EQ_CORE_FIR[23] both use core0_M_th_1.
+    libhei::Signature sig1{p10, 0x682c, 0, 1, libhei::ATTN_TYPE_RECOVERABLE};
+    libhei::Signature sig2{p10, 0x682c, 0, 23, libhei::ATTN_TYPE_RECOVERABLE};
+
+    // Each action is compiled once and shared by all signatures and threads.
+    auto resolution = rasData.getResolution(sig1);
+    ASSERT_NE(nullptr, resolution);
+    EXPECT_EQ(resolution, rasData.getResolution(sig2));
+
+    std::vector<std::thread> threads;
+    std::vector<std::shared_ptr<Resolution>> results(4);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        threads.emplace_back(
+            [&, i] { results[i] = rasData.getResolution(sig1); });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (const auto& r : results)
+    {
+        EXPECT_EQ(resolution, r);
+    }
+}
+
+TEST(RasDataParser, FilterRules)
+{
+    RasDataParser rasData{};
+
+    for (libhei::ChipType_t type : {0x20da0020, 0x60d20020})
+    {
+        auto rules = rasData.getFilterRules(type);
+        ASSERT_FALSE(rules.empty());
+
+        // The rules must be sorted by rank and the same view is returned for
+        // each call.
+        EXPECT_TRUE(std::ranges::is_sorted(rules, {},
+                                           &RasDataParser::FilterRule::rank));
+        EXPECT_EQ(rules.data(), rasData.getFilterRules(type).data());
+    }
+
+    // The first P10 rule is for the RCS OSC errors, TP_LOCAL_FIR[42,43].
+    const auto& rcsOsc = rasData.getFilterRules(0x20da0020).front();
+    EXPECT_EQ(0u, rcsOsc.rank);
+    EXPECT_EQ(NodeMatch::EQUAL, rcsOsc.nodeMatch);
+    EXPECT_EQ(libhei::hash<libhei::NodeId_t>("TP_LOCAL_FIR"), rcsOsc.node);
+    EXPECT_EQ(uint64_t{3} << 42, rcsOsc.bits);
+
+    // There is no RAS data for this chip type.
+    EXPECT_THROW(rasData.getFilterRules(0xdeadbeef), std::out_of_range);
+}
@@ -57,9 +57,9 @@ TEST(Resolution, TestSet1)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd1{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                    libhei::IsolationData{}};
+                    std::make_shared<libhei::IsolationData>()};
     ServiceData sd2{sig, AnalysisType::TERMINATE_IMMEDIATE,
-                    libhei::IsolationData{}};
+                    std::make_shared<libhei::IsolationData>()};
 
     // Resolve
     l1->resolve(sd1);
@@ -150,7 +150,7 @@ TEST(Resolution, HardwareCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     c1->resolve(sd);
 
@@ -205,7 +205,7 @@ TEST(Resolution, ConnectedCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     nlohmann::json j{};
     std::string s{};
@@ -296,7 +296,7 @@ TEST(Resolution, BusCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     nlohmann::json j{};
     std::string s{};
@@ -391,7 +391,7 @@ TEST(Resolution, ClockCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     c1->resolve(sd);
 
@@ -437,7 +437,7 @@ TEST(Resolution, ProcedureCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     c1->resolve(sd);
 
@@ -481,7 +481,7 @@ TEST(Resolution, PartCallout)
     libhei::Chip chip{util::pdbg::getTrgt(chip_str), 0xdeadbeef};
     libhei::Signature sig{chip, 0xabcd, 0, 0, libhei::ATTN_TYPE_CHIP_CS};
     ServiceData sd{sig, AnalysisType::SYSTEM_CHECKSTOP,
-                   libhei::IsolationData{}};
+                   std::make_shared<libhei::IsolationData>()};
 
     c1->resolve(sd);
 
@@ -0,0 +1,267 @@
+#include <analyzer/analyzer_main.hpp>
+#include <analyzer/plugins/plugin.hpp>
+#include <analyzer/ras-data/ras-data-parser.hpp>
+#include <hei_util.hpp>
+#include <util/pdbg.hpp>
+#include <util/trace.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace analyzer
+{
+// Forward reference of findRootCause
+bool findRootCause(AnalysisType i_type, const libhei::IsolationData& i_isoData,
+                   libhei::Signature& o_rootCause,
+                   const RasDataParser& i_rasData);
+} // namespace analyzer
+
+using namespace analyzer;
+
+namespace
+{
+
+using namespace util::pdbg;
+using rdf = RasDataParser::RasDataFlags;
+using SigList = std::vector<libhei::Signature>;
+
+libhei::NodeId_t __hash(const char* i_str)
+{
+    return libhei::hash<libhei::NodeId_t>(i_str);
+}
+
+// The multi-pass filter chain that findRootCause() replaced. Each pass looks
+// for the first signature in the list that matches a rule, in order of
+// precedence. This is kept here only as a reference for the equivalence test
+// below, which verifies the filter rules in the RAS data produce the same
+// results.
+
+template <typename Pred>
+bool __findFirst(const SigList& i_list, libhei::Signature& o_rootCause,
+                 Pred i_pred)
+{
+    auto itr = std::find_if(i_list.begin(), i_list.end(), i_pred);
+    if (i_list.end() != itr)
+    {
+        o_rootCause = *itr;
+        return true;
+    }
+    return false;
+}
+
+bool __legacyFindRootCause(AnalysisType i_type, const SigList& i_list,
+                           libhei::Signature& o_rootCause,
+                           const RasDataParser& i_rasData)
+{
+    auto trgtType = [](const libhei::Signature& s) {
+        return getTrgtType(getTrgt(s.getChip()));
+    };
+
+    auto isP10 = [](const libhei::Signature& s) {
+        return P10_10 == s.getChip().getType() ||
+               P10_20 == s.getChip().getType();
+    };
+
+    auto isFlagSet = [&](const libhei::Signature& s, rdf f) {
+        return i_rasData.isFlagSet(s, f);
+    };
+
+    if (i_list.empty())
+    {
+        return false;
+    }
+
+    // RCS OSC errors
+    if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return isP10(s) && __hash("TP_LOCAL_FIR") == s.getId() &&
+                   (42 == s.getBit() || 43 == s.getBit());
+        }))
+    {
+        return true;
+    }
+
+    // PLL unlock, processors then OCMBs
+    for (auto type : {TYPE_PROC, TYPE_OCMB})
+    {
+        if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+                return __hash("PLL_UNLOCK") == s.getId() && type == trgtType(s);
+            }))
+        {
+            return true;
+        }
+    }
+
+    // TOD errors
+    if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return __hash("TOD_ERROR") == s.getId() && TYPE_PROC == trgtType(s);
+        }))
+    {
+        return true;
+    }
+
+    // OCMB checkstops
+    if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return TYPE_OCMB == trgtType(s) &&
+                   (libhei::ATTN_TYPE_CHIP_CS == s.getAttnType() ||
+                    libhei::ATTN_TYPE_UNIT_CS == s.getAttnType());
+        }))
+    {
+        return true;
+    }
+
+    // Channel failures
+    if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return TYPE_PROC == trgtType(s) &&
+                   ((libhei::ATTN_TYPE_UNIT_CS == s.getAttnType() &&
+                     (__hash("MC_DSTL_FIR") == s.getId() ||
+                      __hash("MC_USTL_FIR") == s.getId()) &&
+                     isP10(s) && !isFlagSet(s, rdf::ATTN_FROM_OCMB)) ||
+                    __hash("MC_OMI_DL_ERR_RPT") == s.getId());
+        }))
+    {
+        return true;
+    }
+
+    // Checkstop root causes, recoverables then unit checkstops
+    for (auto type : {libhei::ATTN_TYPE_RECOVERABLE, libhei::ATTN_TYPE_UNIT_CS})
+    {
+        if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+                return type == s.getAttnType() &&
+                       (isFlagSet(s, rdf::CS_POSSIBLE) ||
+                        isFlagSet(s, rdf::SUE_SOURCE));
+            }))
+        {
+            return true;
+        }
+    }
+
+    // Attentions from an inaccessible OCMB
+    if (std::none_of(i_list.begin(), i_list.end(), [&](const auto& s) {
+            return TYPE_OCMB == trgtType(s);
+        }) &&
+        __findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return isFlagSet(s, rdf::ATTN_FROM_OCMB);
+        }))
+    {
+        return true;
+    }
+
+    // Non-external checkstops
+    if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+            return TYPE_PROC == trgtType(s) &&
+                   libhei::ATTN_TYPE_CHIP_CS == s.getAttnType() &&
+                   __hash("PB_EXT_FIR") != s.getId();
+        }))
+    {
+        return true;
+    }
+
+    if (AnalysisType::SYSTEM_CHECKSTOP != i_type)
+    {
+        // TI root causes
+        if (__findFirst(i_list, o_rootCause, [&](const auto& s) {
+                return (libhei::ATTN_TYPE_RECOVERABLE == s.getAttnType() ||
+                        libhei::ATTN_TYPE_UNIT_CS == s.getAttnType()) &&
+                       !isFlagSet(s, rdf::RECOVERED_ERROR) &&
+                       !isFlagSet(s, rdf::INFORMATIONAL_ONLY) &&
+                       !isFlagSet(s, rdf::MNFG_INFORMATIONAL_ONLY) &&
+                       !isFlagSet(s, rdf::ATTN_FROM_OCMB);
+            }))
+        {
+            return true;
+        }
+
+        if (AnalysisType::TERMINATE_IMMEDIATE != i_type)
+        {
+            o_rootCause = i_list.front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+TEST(RootCauseClassifier, MatchesLegacyFilterChain)
+{
+    pdbg_targets_init(nullptr);
+
+    RasDataParser rasData{};
+
+    std::vector<libhei::Chip> chips{
+        {getTrgt("/proc0"), P10_20},
+        {getTrgt("/proc0"), P10_10},
+        {getTrgt("proc0/pib/perv12/mc0/mi0/mcc0/omi0/ocmb0"), EXPLORER_20},
+    };
+
+    // A mix of the nodes used by the root cause rules and other nodes with
+    // interesting RAS data flags.
+    std::vector<libhei::NodeId_t> procNodes{
+        __hash("TP_LOCAL_FIR"),
+        __hash("PLL_UNLOCK"),
+        __hash("TOD_ERROR"),
+        __hash("MC_DSTL_FIR"),
+        __hash("MC_USTL_FIR"),
+        __hash("MC_OMI_DL_ERR_RPT"),
+        __hash("PB_EXT_FIR"),
+        __hash("EQ_CORE_FIR"),
+        __hash("MC_OMI_DL_FIR"),
+        __hash("N1_LOCAL_FIR"),
+    };
+
+    std::vector<libhei::NodeId_t> ocmbNodes{
+        __hash("PLL_UNLOCK"), __hash("RDFFIR"),    __hash("SRQFIR"),
+        __hash("MCBISTFIR"),  __hash("OCMB_LFIR"), __hash("MMIOFIR"),
+    };
+
+    std::vector<libhei::AttentionType_t> attnTypes{
+        libhei::ATTN_TYPE_CHIP_CS, libhei::ATTN_TYPE_UNIT_CS,
+        libhei::ATTN_TYPE_RECOVERABLE, libhei::ATTN_TYPE_SP_ATTN,
+        libhei::ATTN_TYPE_HOST_ATTN};
+
+    std::vector<AnalysisType> analysisTypes{AnalysisType::SYSTEM_CHECKSTOP,
+                                            AnalysisType::TERMINATE_IMMEDIATE,
+                                            AnalysisType::MANUAL};
+
+    std::mt19937 gen{0x5eed};
+
+    auto pick = [&](const auto& v) {
+        return v[std::uniform_int_distribution<size_t>{0, v.size() - 1}(gen)];
+    };
+
+    for (unsigned int i = 0; i < 2000; i++)
+    {
+        libhei::IsolationData isoData{};
+
+        // Include empty lists and lists big enough to hit several rules.
+        auto size = std::uniform_int_distribution<unsigned int>{0, 12}(gen);
+        for (unsigned int j = 0; j < size; j++)
+        {
+            auto chip = pick(chips);
+            auto node = (EXPLORER_20 == chip.getType()) ? pick(ocmbNodes)
+                                                        : pick(procNodes);
+            auto bit = std::uniform_int_distribution<unsigned int>{0, 63}(gen);
+
+            isoData.addSignature({chip, node, 0,
+                                  static_cast<libhei::BitPosition_t>(bit),
+                                  pick(attnTypes)});
+        }
+
+        for (auto type : analysisTypes)
+        {
+            libhei::Signature expSig, actSig;
+            bool expFound = __legacyFindRootCause(
+                type, isoData.getSignatureList(), expSig, rasData);
+            bool actFound = findRootCause(type, isoData, actSig, rasData);
+
+            ASSERT_EQ(expFound, actFound) << "iteration " << i;
+            if (expFound)
+            {
+                ASSERT_EQ(expSig, actSig) << "iteration " << i;
+            }
+        }
+    }
+}
@@ -55,10 +55,10 @@ TEST(TodStepCheckFault, MdmtFault)
     // TOD_ERROR(0)[21] step check error on slave select 1
     libhei::Signature sig2{chip1, nodeId, 0, 21, libhei::ATTN_TYPE_CHIP_CS};
 
-    libhei::IsolationData isoData{};
-    isoData.addSignature(sig0);
-    isoData.addSignature(sig1);
-    isoData.addSignature(sig2);
+    auto isoData = std::make_shared<libhei::IsolationData>();
+    isoData->addSignature(sig0);
+    isoData->addSignature(sig1);
+    isoData->addSignature(sig2);
     ServiceData sd{sig1, AnalysisType::SYSTEM_CHECKSTOP, isoData};
 
     // Call the plugin.
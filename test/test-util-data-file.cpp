@@ -94,3 +94,52 @@ TEST(UtilDataFile, TestValidateJson)
 
     EXPECT_FALSE(util::validateJson(schema_obj, json_obj1));
 }
+
+TEST(UtilDataFile, TestValidationCache)
+{
+    json schema_obj = R"({
+    "type": "object",
+    "additionalProperties": false,
+    "properties": {
+        "version": {
+            "type": "integer"
+        }
+    }
+})"_json;
+
+    json json_obj = R"({ "version" : 1 })"_json;
+    json json_obj1 = R"({ "version_1" : 1 })"_json;
+
+    auto hash = ValidationCache::hash(json_obj.dump(),
+                                      ValidationCache::hash(schema_obj.dump()));
+    auto hash1 = ValidationCache::hash(
+        json_obj1.dump(), ValidationCache::hash(schema_obj.dump()));
+    EXPECT_NE(hash, hash1);
+
+    // Start with an empty cache file.
+    TemporaryFile tempFile{};
+
+    {
+        ValidationCache cache{tempFile.getPath()};
+
+        // The first validation is a miss. The second is a hit.
+        EXPECT_TRUE(cache.validate(schema_obj, json_obj, hash));
+        EXPECT_TRUE(cache.validate(schema_obj, json_obj, hash));
+        EXPECT_EQ(1u, cache.getHits());
+        EXPECT_EQ(1u, cache.getMisses());
+
+        // Failures are never cached.
+        EXPECT_FALSE(cache.validate(schema_obj, json_obj1, hash1));
+        EXPECT_FALSE(cache.validate(schema_obj, json_obj1, hash1));
+        EXPECT_EQ(1u, cache.getHits());
+        EXPECT_EQ(3u, cache.getMisses());
+    }
+
+    // The successful result was saved to the cache file.
+    ValidationCache cache{tempFile.getPath()};
+    EXPECT_TRUE(cache.validate(schema_obj, json_obj, hash));
+    EXPECT_EQ(1u, cache.getHits());
+    EXPECT_EQ(0u, cache.getMisses());
+
+    tempFile.remove();
+}
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <ostream>
 
 namespace util
 {
@@ -118,9 +119,16 @@ class BinFileWriter
      * @param f The name of the target file.
      */
     explicit BinFileWriter(const std::filesystem::path& p) :
-        iv_stream(p, std::ios::binary)
+        iv_file(p, std::ios::binary), iv_stream(iv_file)
     {}
 
+    /**
+     * @brief Constructor.
+     * @param s An existing output stream (e.g. from an FFDC file). The stream
+     *          must outlive this object.
+     */
+    explicit BinFileWriter(std::ostream& s) : iv_stream(s) {}
+
     /** @brief Destructor. */
     ~BinFileWriter() = default;
 
@@ -131,8 +139,11 @@ class BinFileWriter
     BinFileWriter& operator=(const BinFileWriter&) = delete;
 
   private:
-    /** The output file stream. */
-    std::ofstream iv_stream;
+    /** The output file stream, if constructed from a file name. */
+    std::ofstream iv_file;
+
+    /** The output stream. */
+    std::ostream& iv_stream;
 
   public:
     /** @return True, if the state of the stream is good. */
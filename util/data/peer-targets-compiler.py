@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+"""
+Compiles a peer target JSON file, which maps the devtree path of each SMP bus
+endpoint to the devtree path of the endpoint on the other side of the bus, into
+the binary peer target image consumed by util::readPeerTargets() (see
+util/peer_targets.hpp).
+
+The image layout (all values little-endian):
+
+    Header
+    Entry[entries]              sorted by RX path
+    char strings[strings_size]  NUL terminated, offset 0 is the empty string
+
+An endpoint that is not connected has an empty peer path.
+
+Any change to this layout must also bump FORMAT_VERSION here and in
+util/peer_targets.hpp.
+"""
+
+import argparse
+import json
+import struct
+
+MAGIC = 0x50454552  # "PEER"
+FORMAT_VERSION = 1
+
+HEADER = struct.Struct("<IHxxII")
+ENTRY = struct.Struct("<II")
+
+
+class StringTable:
+    """Deduplicated table of NUL terminated strings."""
+
+    def __init__(self):
+        self.data = bytearray(b"\0")
+        self.offsets = {"": 0}
+
+    def add(self, s):
+        if s not in self.offsets:
+            self.offsets[s] = len(self.data)
+            self.data += s.encode("ascii") + b"\0"
+        return self.offsets[s]
+
+
+def compile_data(data):
+    if not isinstance(data, dict):
+        raise ValueError("Peer target file must contain a JSON object")
+
+    strings = StringTable()
+    entries = bytearray()
+
+    for rx in sorted(data):
+        peer = data[rx]
+        if not rx or not isinstance(peer, str):
+            raise ValueError("Invalid peer target entry: '%s'" % rx)
+        entries += ENTRY.pack(strings.add(rx), strings.add(peer))
+
+    # Pad the string table so that the image size is a multiple of 4.
+    while len(strings.data) % 4:
+        strings.data += b"\0"
+
+    header = HEADER.pack(MAGIC, FORMAT_VERSION, len(data), len(strings.data))
+
+    return header + entries + strings.data
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compile a peer target JSON file."
+    )
+    parser.add_argument("-o", "--output", required=True, help="output file")
+    parser.add_argument("input", help="input peer target JSON file")
+    args = parser.parse_args()
+
+    with open(args.input) as f:
+        image = compile_data(json.load(f))
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+
+
+if __name__ == "__main__":
+    main()
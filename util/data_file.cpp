@@ -4,7 +4,10 @@
 #include <valijson/schema_parser.hpp>
 #include <valijson/validator.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <regex>
+#include <system_error>
 
 namespace fs = std::filesystem;
 
@@ -41,4 +44,92 @@ bool validateJson(const nlohmann::json& i_schema, const nlohmann::json& i_json)
     return validator.validate(schema, targetAdapter, nullptr);
 }
 
+ValidationCache::ValidationCache(const fs::path& i_path) : iv_path(i_path)
+{
+    // The file contains one hash per line, in hex.
+    std::ifstream file{iv_path};
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        try
+        {
+            iv_hashes.push_back(std::stoull(line, nullptr, 16));
+        }
+        catch (const std::exception& e)
+        {
+            // Ignore the entire file if it has been corrupted.
+            iv_hashes.clear();
+            break;
+        }
+    }
+}
+
+uint64_t ValidationCache::hash(std::string_view i_data, uint64_t i_seed)
+{
+    uint64_t o_hash = i_seed;
+
+    for (auto c : i_data)
+    {
+        o_hash ^= static_cast<uint8_t>(c);
+        o_hash *= 0x100000001b3;
+    }
+
+    return o_hash;
+}
+
+bool ValidationCache::validate(const nlohmann::json& i_schema,
+                               const nlohmann::json& i_json, uint64_t i_hash)
+{
+    auto itr = std::find(iv_hashes.begin(), iv_hashes.end(), i_hash);
+    if (iv_hashes.end() != itr)
+    {
+        iv_hits++;
+        return true;
+    }
+
+    iv_misses++;
+
+    if (!validateJson(i_schema, i_json))
+    {
+        return false; // Failures are never cached.
+    }
+
+    iv_hashes.push_back(i_hash);
+    if (MAX_ENTRIES < iv_hashes.size())
+    {
+        iv_hashes.erase(iv_hashes.begin());
+    }
+
+    save();
+
+    return true;
+}
+
+void ValidationCache::save() const
+{
+    std::error_code ec; // errors are not fatal, see class description
+    fs::create_directories(iv_path.parent_path(), ec);
+
+    // Write a temporary file and rename it so that a partially written cache
+    // file is never read.
+    auto tmpPath = fs::path{iv_path}.concat(".tmp");
+
+    {
+        std::ofstream file{tmpPath, std::ios::trunc};
+        for (const auto& h : iv_hashes)
+        {
+            file << std::hex << h << '\n';
+        }
+
+        if (!file.good())
+        {
+            fs::remove(tmpPath, ec);
+            return;
+        }
+    }
+
+    fs::rename(tmpPath, iv_path, ec);
+}
+
 } // namespace util
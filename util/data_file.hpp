@@ -1,6 +1,11 @@
+#pragma once
+
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
 #include <filesystem>
+#include <string_view>
+#include <vector>
 
 namespace util
 {
@@ -24,4 +29,78 @@ void findFiles(const std::filesystem::path& i_dirPath,
  */
 bool validateJson(const nlohmann::json& i_schema, const nlohmann::json& i_json);
 
+/**
+ * @brief A persistent record of the JSON documents that have been successfully
+ *        validated against a schema.
+ *
+ * Schema validation of a large document is expensive and the result never
+ * changes for the same document and schema. Each entry is a content hash of a
+ * document and its schema (see hash()). The entries are stored in a small
+ * cache file so that validation is only done once, even across restarts. Any
+ * failure to read or write the cache file is not fatal. The document is simply
+ * validated again.
+ */
+class ValidationCache
+{
+  public:
+    /**
+     * @brief Constructor. Reads the cache file, if it exists.
+     * @param i_path The path to the cache file.
+     */
+    explicit ValidationCache(const std::filesystem::path& i_path);
+
+    /**
+     * @param  i_data The raw contents of a file.
+     * @param  i_seed The hash of any previous contents to include in the hash.
+     * @return A 64-bit FNV-1a hash of the given data.
+     */
+    static uint64_t hash(std::string_view i_data,
+                         uint64_t i_seed = 0xcbf29ce484222325);
+
+    /**
+     * @brief  Validates the given JSON document against the given schema,
+     *         unless the same document and schema have already been validated.
+     *         A successful result is added to the cache file.
+     * @param  i_schema Target schema document.
+     * @param  i_json   Target JSON document.
+     * @param  i_hash   The hash of the raw contents of both the schema and the
+     *                  document (see hash()).
+     * @return True, if validation successful. False, otherwise.
+     */
+    bool validate(const nlohmann::json& i_schema, const nlohmann::json& i_json,
+                  uint64_t i_hash);
+
+    /** @return The number of validations skipped due to a cache hit. */
+    size_t getHits() const
+    {
+        return iv_hits;
+    }
+
+    /** @return The number of validations done due to a cache miss. */
+    size_t getMisses() const
+    {
+        return iv_misses;
+    }
+
+  private:
+    /** The maximum number of entries kept in the cache file. The oldest
+     *  entries are removed first. */
+    static constexpr size_t MAX_ENTRIES = 32;
+
+    /** The path to the cache file. */
+    const std::filesystem::path iv_path;
+
+    /** The hashes of all successfully validated documents, oldest first. */
+    std::vector<uint64_t> iv_hashes;
+
+    /** The number of validations skipped due to a cache hit. */
+    size_t iv_hits = 0;
+
+    /** The number of validations done due to a cache miss. */
+    size_t iv_misses = 0;
+
+    /** @brief Writes all of the entries to the cache file. */
+    void save() const;
+};
+
 } // namespace util
@@ -1,8 +1,12 @@
+#include <sdbusplus/bus/match.hpp>
 #include <util/dbus.hpp>
 #include <util/trace.hpp>
 #include <xyz/openbmc_project/State/Boot/Progress/server.hpp>
 
 #include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
 
 namespace util
 {
@@ -138,13 +142,20 @@ int getProperty(const std::string& i_interface, const std::string& i_path,
     return rc;
 }
 
-/** @brief Get the IBM compatible names defined for this system */
-std::vector<std::string> systemNames()
+constexpr auto compatibleSystemInterface =
+    "xyz.openbmc_project.Configuration.IBMCompatibleSystem";
+
+constexpr auto vsbpInterface = "com.ibm.ipzvpd.VSBP";
+
+/**
+ * @brief  Read the IBM compatible names defined for this system from dbus
+ * @return The names, or an empty optional if they could not be read.
+ */
+std::optional<std::vector<std::string>> __readSystemNames()
 {
-    std::vector<std::string> names;
+    std::optional<std::vector<std::string>> names;
 
-    constexpr auto interface =
-        "xyz.openbmc_project.Configuration.IBMCompatibleSystem";
+    constexpr auto interface = compatibleSystemInterface;
 
     DBusService service;
     DBusPath path;
@@ -390,15 +401,69 @@ uint32_t createPel(const std::string& i_message, const std::string& i_severity,
     return plid; // platform log id or 0
 }
 
-MachineType getMachineType()
+/**
+ * @brief  Converts the System IM keyword to a machine type.
+ * @param  i_ids The value of the IM keyword (4 bytes).
+ * @return The machine type.
+ * @throw  std::out_of_range if the value is not a known machine type.
+ */
+MachineType __toMachineType(const std::vector<uint8_t>& i_ids)
 {
-    // default to Rainier 2S4U
-    MachineType machineType = MachineType::Rainier_2S4U;
+    // Convert the returned ID value to a hex string to determine
+    // machine type. The hex values corresponding to the machine type
+    // are defined in /openbmc/openpower-vpd-parser/const.hpp
+    // RAINIER_2S4U == 0x50001000
+    // RAINIER_2S2U == 0x50001001
+    // RAINIER_1S4U == 0x50001002
+    // RAINIER_1S2U == 0x50001003
+    // EVEREST      == 0x50003000
+    // BONNELL      == 0x50004000
+    try
+    {
+        // Format the vector into a single hex string to compare to.
+        std::string hexId =
+            std::format("0x{:02x}{:02x}{:02x}{:02x}", i_ids.at(0), i_ids.at(1),
+                        i_ids.at(2), i_ids.at(3));
+
+        static const std::map<std::string, MachineType> typeMap = {
+            {"0x50001000", MachineType::Rainier_2S4U},
+            {"0x50001001", MachineType::Rainier_2S2U},
+            {"0x50001002", MachineType::Rainier_1S4U},
+            {"0x50001003", MachineType::Rainier_1S2U},
+            {"0x50003000", MachineType::Everest},
+            {"0x50004000", MachineType::Bonnell},
+            {"0x60001000", MachineType::BlueRidge_2S4U},
+            {"0x60001001", MachineType::BlueRidge_2S2U},
+            {"0x60001002", MachineType::BlueRidge_1S4U},
+            {"0x60002000", MachineType::Fuji},
+            {"0x60004000", MachineType::Balcones},
+        };
+
+        return typeMap.at(hexId);
+    }
+    catch (const std::out_of_range& e)
+    {
+        trace::err("Out of range exception caught from returned "
+                   "machine ID.");
+        for (const auto& id : i_ids)
+        {
+            trace::err("Returned Machine ID value: 0x%x", id);
+        }
+        throw;
+    }
+}
 
-    // The return value of the dbus operation is a vector of 4 uint8_ts
-    std::vector<uint8_t> ids;
+/**
+ * @brief  Read the System IM keyword from dbus to get the machine type
+ * @return The machine type, or an empty optional if the keyword could not be
+ *         read.
+ * @throw  std::invalid_argument if the dbus service could not be found.
+ */
+std::optional<MachineType> __readMachineType()
+{
+    std::optional<MachineType> machineType;
 
-    constexpr auto interface = "com.ibm.ipzvpd.VSBP";
+    constexpr auto interface = vsbpInterface;
 
     DBusService service;
     DBusPath path;
@@ -413,50 +478,8 @@ MachineType getMachineType()
         if (0 == getProperty(interface, path, service, property, value))
         {
             // return value is a variant, ID value is a vector of 4 uint8_ts
-            ids = std::get<std::vector<uint8_t>>(value);
-
-            // Convert the returned ID value to a hex string to determine
-            // machine type. The hex values corresponding to the machine type
-            // are defined in /openbmc/openpower-vpd-parser/const.hpp
-            // RAINIER_2S4U == 0x50001000
-            // RAINIER_2S2U == 0x50001001
-            // RAINIER_1S4U == 0x50001002
-            // RAINIER_1S2U == 0x50001003
-            // EVEREST      == 0x50003000
-            // BONNELL      == 0x50004000
-            try
-            {
-                // Format the vector into a single hex string to compare to.
-                std::string hexId =
-                    std::format("0x{:02x}{:02x}{:02x}{:02x}", ids.at(0),
-                                ids.at(1), ids.at(2), ids.at(3));
-
-                std::map<std::string, MachineType> typeMap = {
-                    {"0x50001000", MachineType::Rainier_2S4U},
-                    {"0x50001001", MachineType::Rainier_2S2U},
-                    {"0x50001002", MachineType::Rainier_1S4U},
-                    {"0x50001003", MachineType::Rainier_1S2U},
-                    {"0x50003000", MachineType::Everest},
-                    {"0x50004000", MachineType::Bonnell},
-                    {"0x60001000", MachineType::BlueRidge_2S4U},
-                    {"0x60001001", MachineType::BlueRidge_2S2U},
-                    {"0x60001002", MachineType::BlueRidge_1S4U},
-                    {"0x60002000", MachineType::Fuji},
-                    {"0x60004000", MachineType::Balcones},
-                };
-
-                machineType = typeMap.at(hexId);
-            }
-            catch (const std::out_of_range& e)
-            {
-                trace::err("Out of range exception caught from returned "
-                           "machine ID.");
-                for (const auto& id : ids)
-                {
-                    trace::err("Returned Machine ID value: 0x%x", id);
-                }
-                throw;
-            }
+            machineType =
+                __toMachineType(std::get<std::vector<uint8_t>>(value));
         }
     }
     else
@@ -468,6 +491,168 @@ MachineType getMachineType()
     return machineType;
 }
 
+//------------------------------------------------------------------------------
+
+/**
+ * @brief The identity of this system. Each value is read from dbus the first
+ *        time it is needed and then only updated by the dbus signals watched
+ *        by watchSystemIdentity(). Access is protected by __identityMutex.
+ */
+struct SystemIdentity
+{
+    /** The machine type, if known. */
+    std::optional<MachineType> machineType;
+
+    /** The IBM compatible system names, if known. */
+    std::optional<std::vector<std::string>> systemNames;
+};
+
+SystemIdentity __identity;
+std::mutex __identityMutex;
+
+// The signal matches that keep __identity up to date.
+std::vector<std::unique_ptr<sdbusplus::match>> __identityMatches;
+
+/**
+ * @brief Updates the system identity with the given properties of the given
+ *        interface. Any other interface is ignored.
+ * @param i_interface  The interface of the properties.
+ * @param i_properties The properties that have changed or were added.
+ */
+void __updateIdentity(const std::string& i_interface,
+                      const std::map<std::string, DBusValue>& i_properties)
+{
+    if (compatibleSystemInterface == i_interface)
+    {
+        auto itr = i_properties.find("Names");
+        if (i_properties.end() != itr)
+        {
+            std::scoped_lock lock{__identityMutex};
+            __identity.systemNames =
+                std::get<std::vector<std::string>>(itr->second);
+        }
+    }
+    else if (vsbpInterface == i_interface)
+    {
+        auto itr = i_properties.find("IM");
+        if (i_properties.end() != itr)
+        {
+            std::scoped_lock lock{__identityMutex};
+
+            // If the new value is not valid, drop the cached value so that
+            // the error is reported by the next getMachineType().
+            __identity.machineType.reset();
+            __identity.machineType =
+                __toMachineType(std::get<std::vector<uint8_t>>(itr->second));
+        }
+    }
+}
+
+void watchSystemIdentity(sdbusplus::bus_t& i_bus)
+{
+    namespace rules = sdbusplus::match_rules;
+
+    auto callback = [](sdbusplus::message_t& i_msg) {
+        try
+        {
+            if (std::string{"InterfacesAdded"} == i_msg.get_member())
+            {
+                sdbusplus::message::object_path path;
+                std::map<std::string, std::map<std::string, DBusValue>> ifaces;
+                i_msg.read(path, ifaces);
+
+                for (const auto& [interface, properties] : ifaces)
+                {
+                    __updateIdentity(interface, properties);
+                }
+            }
+            else // PropertiesChanged
+            {
+                std::string interface;
+                std::map<std::string, DBusValue> properties;
+                i_msg.read(interface, properties);
+
+                __updateIdentity(interface, properties);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            trace::err("util::dbus::watchSystemIdentity exception");
+            trace::err(e.what());
+        }
+    };
+
+    __identityMatches.clear();
+
+    // Only objects added under the inventory can carry the system identity.
+    __identityMatches.push_back(std::make_unique<sdbusplus::match>(
+        i_bus,
+        rules::interfacesAdded() +
+            rules::argNpath(0, "/xyz/openbmc_project/inventory/"),
+        callback));
+
+    for (const auto& interface : {compatibleSystemInterface, vsbpInterface})
+    {
+        __identityMatches.push_back(std::make_unique<sdbusplus::match>(
+            i_bus,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, interface),
+            callback));
+    }
+
+    // Populate the cache now that any changes will be caught by the signals.
+    try
+    {
+        trace::inf("Machine type: %u",
+                   static_cast<unsigned int>(getMachineType()));
+        trace::inf("System names: %zu", systemNames().size());
+    }
+    catch (const std::exception& e)
+    {
+        // Not fatal, the values will be read again when needed.
+        trace::err("Unable to read system identity: %s", e.what());
+    }
+}
+
+std::vector<std::string> systemNames()
+{
+    std::scoped_lock lock{__identityMutex};
+
+    // Errors are not cached. The names will be read again next time.
+    if (!__identity.systemNames)
+    {
+        auto names = __readSystemNames();
+        if (!names)
+        {
+            return {};
+        }
+
+        __identity.systemNames = std::move(names);
+    }
+
+    return *__identity.systemNames;
+}
+
+MachineType getMachineType()
+{
+    std::scoped_lock lock{__identityMutex};
+
+    // Errors are not cached. The machine type will be read again next time.
+    if (!__identity.machineType)
+    {
+        auto machineType = __readMachineType();
+        if (!machineType)
+        {
+            return MachineType::Rainier_2S4U; // default to Rainier 2S4U
+        }
+
+        __identity.machineType = machineType;
+    }
+
+    return *__identity.machineType;
+}
+
 /** @brief Get list of state effecter PDRs */
 bool getStateEffecterPdrs(std::vector<std::vector<uint8_t>>& pdrList,
                           uint16_t stateSetId)
@@ -85,6 +85,10 @@ void setProperty(const std::string& service, const std::string& object,
 /**
  * Get the IBM compatible names defined for this system
  *
+ * The names are read from dbus on first use and cached (see
+ * watchSystemIdentity()). Errors are not cached. If the names cannot be read,
+ * an empty vector is returned and the names are read again next time.
+ *
  * @return     A vector of strings containing the system names
  */
 std::vector<std::string> systemNames();
@@ -178,10 +182,30 @@ enum class MachineType
 /**
  * @brief Read the System IM keyword to get the machine type
  *
+ * The machine type is read from dbus on first use and cached (see
+ * watchSystemIdentity()). Errors are not cached. If the keyword cannot be read,
+ * the default (Rainier 2S4U) is returned and the keyword is read again next
+ * time.
+ *
  * @return An enum representing the machine type
  */
 MachineType getMachineType();
 
+/**
+ * @brief Keep the cached system identity up to date
+ *
+ * The machine type and the IBM compatible system names are cached by
+ * getMachineType() and systemNames(). This registers signal matches on the
+ * given bus for the InterfacesAdded and PropertiesChanged signals of the
+ * interfaces providing them, so that the cache is updated directly from the
+ * signals instead of querying dbus again. The cache is then populated, if
+ * needed. The bus must be processed by the caller's event loop for the
+ * matches to take effect. Any matches from a previous call are removed.
+ *
+ * @param i_bus The bus to watch.
+ */
+void watchSystemIdentity(sdbusplus::bus_t& i_bus);
+
 /** @brief Get list of state sensor PDRs
  *
  *  @param[out] pdrList - list of PDRs
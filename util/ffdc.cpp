@@ -129,30 +129,25 @@ FFDCFile createFFDCTraceFile(const std::vector<std::string>& lines)
 {
     // Create FFDC file of type Text
     FFDCFile file{FFDCFormat::Text};
-    int fd = file.getFileDescriptor();
+    auto& stream = file.getStream();
 
-    // Write FFDC lines to file
-    std::string buffer;
+    // Write FFDC lines to file.  Add newline if necessary.
     for (const std::string& line : lines)
     {
-        // Copy line to buffer.  Add newline if necessary.
-        buffer = line;
+        stream << line;
         if (line.empty() || (line.back() != '\n'))
         {
-            buffer += '\n';
-        }
-
-        // write buffer to file
-        size_t numBytes = write(fd, buffer.c_str(), buffer.size());
-        if (buffer.size() != numBytes)
-        {
-            trace::err("%s only %u of %u bytes written", file.getPath().c_str(),
-                       numBytes, buffer.size());
+            stream << '\n';
         }
     }
 
-    // Seek to beginning of file so error logging system can read data
-    lseek(fd, 0, SEEK_SET);
+    // Write the data and rewind the file so error logging system can read it
+    file.seal();
+
+    if (!stream.good())
+    {
+        trace::err("Unable to write FFDC trace file");
+    }
 
     return file;
 }
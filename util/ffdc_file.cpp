@@ -1,34 +1,190 @@
 #include "util/ffdc_file.hpp"
 
-#include <errno.h>     // for errno
-#include <fcntl.h>     // for open()
-#include <string.h>    // for strerror()
-#include <sys/stat.h>  // for open()
-#include <sys/types.h> // for open()
+#include <errno.h>    // for errno
+#include <fcntl.h>    // for fcntl()
+#include <string.h>   // for strerror()
+#include <sys/mman.h> // for memfd_create()
+#include <unistd.h>   // for write(), lseek()
 
+#include <algorithm>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <vector>
 
 namespace util
 {
 
-FFDCFile::FFDCFile(FFDCFormat format, uint8_t subType, uint8_t version) :
-    format{format}, subType{subType}, version{version}
+/**
+ * Stream buffer that collects data in memory and writes it to a file
+ * descriptor when the buffer is full or when it is flushed.
+ */
+class FFDCFile::Writer : public std::streambuf
 {
-    // Open the temporary file for both reading and writing
-    int fd = open(tempFile.getPath().c_str(), O_RDWR);
+  public:
+    /**
+     * Constructor.
+     *
+     * @param fd file descriptor to write to
+     * @param capacity initial size of the buffer
+     */
+    Writer(int fd, size_t capacity) :
+        fd{fd}, buffer(std::max(capacity, defaultCapacity))
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    /**
+     * Returns the output stream that writes to this buffer.
+     */
+    std::ostream& getStream()
+    {
+        return stream;
+    }
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!flush())
+        {
+            return traits_type::eof();
+        }
+
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override
+    {
+        return flush() ? 0 : -1;
+    }
+
+  private:
+    /**
+     * Writes all buffered data to the file and empties the buffer.
+     *
+     * @return true if all of the data was written
+     */
+    bool flush()
+    {
+        const char* data = pbase();
+        size_t size = pptr() - pbase();
+
+        while (0 < size)
+        {
+            ssize_t rc = ::write(fd, data, size);
+            if (rc < 0)
+            {
+                if (EINTR == errno)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            data += rc;
+            size -= rc;
+        }
+
+        setp(buffer.data(), buffer.data() + buffer.size());
+
+        return true;
+    }
+
+    /**
+     * Default size of the buffer.
+     */
+    static constexpr size_t defaultCapacity = 4096;
+
+    /**
+     * File descriptor to write to; owned by the FFDCFile.
+     */
+    int fd;
+
+    /**
+     * Buffered data that has not yet been written to the file.
+     */
+    std::vector<char> buffer;
+
+    /**
+     * Output stream that writes to this buffer.
+     */
+    std::ostream stream{this};
+};
+
+FFDCFile::FFDCFile(FFDCFormat format, uint8_t subType, uint8_t version,
+                   size_t capacity) :
+    format{format}, subType{subType}, version{version}, capacity{capacity}
+{
+    // Create an anonymous memory file that can be sealed once it is complete
+    int fd = memfd_create("openpower-hw-diags-ffdc",
+                          MFD_CLOEXEC | MFD_ALLOW_SEALING);
     if (fd == -1)
     {
         throw std::runtime_error{
-            std::string{"Unable to open FFDC file: "} + strerror(errno)};
+            std::string{"Unable to create FFDC file: "} + strerror(errno)};
     }
 
     // Store file descriptor in FileDescriptor object
     descriptor.set(fd);
 }
 
+// The Writer class is only complete in this file
+FFDCFile::FFDCFile(FFDCFile&&) = default;
+FFDCFile& FFDCFile::operator=(FFDCFile&&) = default;
+FFDCFile::~FFDCFile() = default;
+
+std::ostream& FFDCFile::getStream()
+{
+    if (!writer)
+    {
+        writer = std::make_unique<Writer>(descriptor(), capacity);
+    }
+
+    return writer->getStream();
+}
+
+void FFDCFile::seal()
+{
+    if (sealed)
+    {
+        return;
+    }
+
+    // Write any buffered data.  A failure is recorded in the stream state.
+    if (writer)
+    {
+        writer->getStream().flush();
+    }
+
+    // Seek to beginning of file so error logging system can read data
+    if (lseek(descriptor(), 0, SEEK_SET) == -1)
+    {
+        throw std::runtime_error{
+            std::string{"Unable to rewind FFDC file: "} + strerror(errno)};
+    }
+
+    // Prevent any further changes to the file contents or size
+    if (fcntl(descriptor(), F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == -1)
+    {
+        throw std::runtime_error{
+            std::string{"Unable to seal FFDC file: "} + strerror(errno)};
+    }
+
+    sealed = true;
+}
+
 void FFDCFile::remove()
 {
+    // Discard any buffered data
+    writer.reset();
+
     // Close file descriptor.  Does nothing if descriptor was already closed.
     // Returns -1 if close failed.
     if (descriptor.close() == -1)
@@ -36,10 +192,6 @@ void FFDCFile::remove()
         throw std::runtime_error{
             std::string{"Unable to close FFDC file: "} + strerror(errno)};
     }
-
-    // Delete temporary file.  Does nothing if file was already deleted.
-    // Throws an exception if the deletion failed.
-    tempFile.remove();
 }
 
 } // namespace util
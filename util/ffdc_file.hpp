@@ -1,16 +1,15 @@
 #pragma once
 
 #include "util/file_descriptor.hpp"
-#include "util/temporary_file.hpp"
 #include "xyz/openbmc_project/Logging/Create/server.hpp"
 
 #include <cstdint>
-#include <filesystem>
+#include <memory>
+#include <ostream>
 
 namespace util
 {
 
-namespace fs = std::filesystem;
 using FFDCFormat =
     sdbusplus::xyz::openbmc_project::Logging::server::Create::FFDCFormat;
 
@@ -22,13 +21,19 @@ using FFDCFormat =
  * This class is used to store FFDC data in an error log.  The FFDC data is
  * passed to the error logging system using a file descriptor.
  *
- * The constructor creates the file and opens it for both reading and writing.
+ * The file is an anonymous memory file (see memfd_create(2)).  It never exists
+ * in the file system, so it does not use any space in the temporary directory.
  *
- * Use getFileDescriptor() to obtain the file descriptor needed to read or write
- * data to the file.
+ * Use getStream() to write buffered data to the file, or getFileDescriptor()
+ * to write data to the file directly.  Do not mix the two.
  *
- * Use remove() to delete the file.  Otherwise the file will be deleted by the
- * destructor.
+ * Use seal() when all of the data has been written.  This rewinds the file so
+ * the error logging system can read the data from the beginning and prevents
+ * any further changes to the file.
+ *
+ * Use remove() to close the file.  Otherwise the file will be closed by the
+ * destructor.  The memory is released when the last file descriptor for the
+ * file (including any passed to the error logging system) is closed.
  *
  * FFDCFile objects cannot be copied, but they can be moved.  This enables them
  * to be stored in containers like std::vector.
@@ -39,10 +44,10 @@ class FFDCFile
     // Specify which compiler-generated methods we want
     FFDCFile() = delete;
     FFDCFile(const FFDCFile&) = delete;
-    FFDCFile(FFDCFile&&) = default;
+    FFDCFile(FFDCFile&&);
     FFDCFile& operator=(const FFDCFile&) = delete;
-    FFDCFile& operator=(FFDCFile&&) = default;
-    ~FFDCFile() = default;
+    FFDCFile& operator=(FFDCFile&&);
+    ~FFDCFile();
 
     /**
      * Constructor.
@@ -54,9 +59,12 @@ class FFDCFile
      * @param format format type of the contained data
      * @param subType format subtype; used for the 'Custom' type
      * @param version version of the data format; used for the 'Custom' type
+     * @param capacity expected size of the data, if known; the stream buffer
+     *                 is pre-sized so that data up to this size is written to
+     *                 the file all at once
      */
     explicit FFDCFile(FFDCFormat format, uint8_t subType = 0,
-                      uint8_t version = 0);
+                      uint8_t version = 0, size_t capacity = 0);
 
     /**
      * Returns the file descriptor for the file.
@@ -82,14 +90,14 @@ class FFDCFile
     }
 
     /**
-     * Returns the absolute path to the file.
+     * Returns a buffered output stream for writing to the file.
+     *
+     * The buffer is flushed to the file by seal().  Check the state of the
+     * stream after seal() to determine if all of the data was written.
      *
-     * @return absolute path
+     * @return output stream
      */
-    const fs::path& getPath() const
-    {
-        return tempFile.getPath();
-    }
+    std::ostream& getStream();
 
     /**
      * Returns the format subtype.
@@ -112,7 +120,18 @@ class FFDCFile
     }
 
     /**
-     * Closes and deletes the file.
+     * Flushes any buffered data to the file, rewinds the file to the
+     * beginning, and seals the file so that it cannot be written, resized, or
+     * sealed again.
+     *
+     * Does nothing if the file has already been sealed.
+     *
+     * Throws an exception if an error occurs.
+     */
+    void seal();
+
+    /**
+     * Closes the file.
      *
      * Does nothing if the file has already been removed.
      *
@@ -137,12 +156,20 @@ class FFDCFile
     uint8_t version{0};
 
     /**
-     * Temporary file where FFDC data is stored.
-     *
-     * The TemporaryFile destructor will automatically delete the file if it was
-     * not explicitly deleted using remove().
+     * Expected size of the data; used to pre-size the stream buffer.
+     */
+    size_t capacity{0};
+
+    /**
+     * Whether the file has been sealed.
+     */
+    bool sealed{false};
+
+    /**
+     * Buffered output stream; created on first use by getStream().
      */
-    TemporaryFile tempFile{};
+    class Writer;
+    std::unique_ptr<Writer> writer{};
 
     /**
      * File descriptor for reading from/writing to the file.
@@ -156,7 +183,7 @@ class FFDCFile
 using FFDCTuple =
     std::tuple<FFDCFormat, uint8_t, uint8_t, sdbusplus::message::unix_fd>;
 
-/** Transforms a list of FFDC files to a list of FFDC tuples. */
+/** Transforms a list of sealed FFDC files to a list of FFDC tuples. */
 inline void transformFFDC(const std::vector<FFDCFile>& i_files,
                           std::vector<FFDCTuple>& o_tuples)
 {
@@ -0,0 +1,95 @@
+#include "util/mapped_file.hpp"
+
+#include <errno.h>     // for errno
+#include <fcntl.h>     // for open()
+#include <string.h>    // for strerror()
+#include <sys/mman.h>  // for mmap()
+#include <sys/stat.h>  // for fstat()
+#include <sys/types.h> // for open()
+#include <unistd.h>    // for close()
+
+#include <stdexcept>
+#include <string>
+
+namespace util
+{
+
+MappedFile::MappedFile(const fs::path& path, Access access)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw std::runtime_error{"Unable to open file: " + path.string() +
+                                 ": " + strerror(errno)};
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+    {
+        int savedErrno = errno;
+        close(fd);
+        throw std::runtime_error{"Unable to stat file: " + path.string() +
+                                 ": " + strerror(savedErrno)};
+    }
+
+    // A zero length mapping is not allowed. Leave the object without a mapping
+    // and let the caller deal with the empty file.
+    if (st.st_size > 0)
+    {
+        void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            int savedErrno = errno;
+            close(fd);
+            throw std::runtime_error{"Unable to map file: " + path.string() +
+                                     ": " + strerror(savedErrno)};
+        }
+
+        addr = ptr;
+        len = st.st_size;
+
+        // The advice only tunes paging. So a failure is not an error.
+        switch (access)
+        {
+            case Access::SEQUENTIAL:
+                madvise(addr, len, MADV_SEQUENTIAL);
+                break;
+            case Access::RANDOM:
+                madvise(addr, len, MADV_RANDOM);
+                break;
+            case Access::NORMAL:
+                break;
+        }
+    }
+
+    // The mapping does not need the file descriptor to remain open.
+    close(fd);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& file)
+{
+    // Verify not assigning object to itself (a = std::move(a))
+    if (this != &file)
+    {
+        unmap();
+
+        addr = file.addr;
+        len = file.len;
+
+        file.addr = nullptr;
+        file.len = 0;
+    }
+    return *this;
+}
+
+void MappedFile::unmap()
+{
+    if (addr != nullptr)
+    {
+        munmap(addr, len);
+        addr = nullptr;
+        len = 0;
+    }
+}
+
+} // namespace util
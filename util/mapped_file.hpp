@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace util
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class MappedFile
+ *
+ * A read-only file mapped into memory.
+ *
+ * The constructor opens the file and maps the entire contents into memory. The
+ * file descriptor is closed immediately after the mapping is created because
+ * the mapping remains valid without it.
+ *
+ * Use data() and size() to access the mapped contents. The mapping is removed
+ * by the destructor.
+ *
+ * The mapping is private and read-only, so the contents are only paged in from
+ * the file as they are accessed and never copied. The expected access pattern
+ * can be given to the kernel to tune read-ahead (see Access).
+ *
+ * MappedFile objects cannot be copied, but they can be moved.  This enables
+ * them to be stored in containers like std::vector.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * The expected access pattern of the mapped contents (see madvise(2)).
+     */
+    enum class Access
+    {
+        NORMAL,     ///< No special treatment.
+        SEQUENTIAL, ///< Read once from start to end (aggressive read-ahead).
+        RANDOM,     ///< Random lookups (no read-ahead).
+    };
+
+    // Specify which compiler-generated methods we want
+    MappedFile() = delete;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Constructor.
+     *
+     * Opens the given file and maps it into memory.
+     *
+     * Throws an exception if the file cannot be opened or mapped.
+     *
+     * @param path   path to the file to map
+     * @param access expected access pattern of the mapped contents
+     */
+    explicit MappedFile(const fs::path& path, Access access = Access::NORMAL);
+
+    /**
+     * Move constructor.
+     *
+     * Transfers ownership of the mapping.
+     *
+     * @param file MappedFile object being moved
+     */
+    MappedFile(MappedFile&& file) : addr{file.addr}, len{file.len}
+    {
+        file.addr = nullptr;
+        file.len = 0;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * Unmaps the file owned by this object. Then transfers ownership of the
+     * mapping owned by the other object.
+     *
+     * @param file MappedFile object being moved
+     */
+    MappedFile& operator=(MappedFile&& file);
+
+    /**
+     * Destructor.
+     *
+     * Unmaps the file if necessary.
+     */
+    ~MappedFile()
+    {
+        unmap();
+    }
+
+    /**
+     * Returns a pointer to the start of the mapped contents.
+     *
+     * Returns nullptr if the file is empty.
+     *
+     * @return start of the mapped contents
+     */
+    const uint8_t* data() const
+    {
+        return static_cast<const uint8_t*>(addr);
+    }
+
+    /**
+     * Returns the size of the mapped contents in bytes.
+     *
+     * @return size of the mapped contents
+     */
+    size_t size() const
+    {
+        return len;
+    }
+
+    /**
+     * Returns the mapped contents as characters (i.e. for text files).
+     *
+     * @return view of the mapped contents
+     */
+    std::string_view chars() const
+    {
+        return {static_cast<const char*>(addr), len};
+    }
+
+  private:
+    /**
+     * Removes the mapping.
+     *
+     * Does nothing if there is no mapping.
+     */
+    void unmap();
+
+    /**
+     * Start address of the mapping. nullptr when there is no mapping.
+     */
+    void* addr{nullptr};
+
+    /**
+     * Length of the mapping in bytes.
+     */
+    size_t len{0};
+};
+
+} // namespace util
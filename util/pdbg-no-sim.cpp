@@ -45,7 +45,7 @@ bool queryLpcTimeout(pdbg_target* target)
 
 //------------------------------------------------------------------------------
 
-int getScom(pdbg_target* i_target, uint64_t i_addr, uint64_t& o_val)
+int __getScom(pdbg_target* i_target, uint64_t i_addr, uint64_t& o_val)
 {
     assert(nullptr != i_target);
 
@@ -80,7 +80,7 @@ int getScom(pdbg_target* i_target, uint64_t i_addr, uint64_t& o_val)
 
 //------------------------------------------------------------------------------
 
-int getCfam(pdbg_target* i_target, uint32_t i_addr, uint32_t& o_val)
+int __getCfam(pdbg_target* i_target, uint32_t i_addr, uint32_t& o_val)
 {
     assert(nullptr != i_target);
     assert(TYPE_PROC == getTrgtType(i_target));
@@ -9,14 +9,18 @@
 #include <config.h>
 
 #include <hei_main.hpp>
-#include <nlohmann/json.hpp>
 #include <util/dbus.hpp>
 #include <util/pdbg.hpp>
+#include <util/peer_targets.hpp>
 #include <util/trace.hpp>
 
+#include <atomic>
 #include <filesystem>
-#include <fstream>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 #ifdef CONFIG_PHAL_API
 #include <attributes_info.H>
@@ -60,11 +64,178 @@ const char* getPath(const libhei::Chip& i_chip)
 
 //------------------------------------------------------------------------------
 
+/**
+ * @brief The attributes of a target that are needed repeatedly during
+ *        analysis. These are read from the device tree once per target.
+ */
+struct TargetAttributes
+{
+    /** ATTR_TYPE */
+    uint8_t type = 0;
+
+    /** ATTR_FAPI_POS */
+    uint32_t chipPos = 0;
+
+    /** ATTR_CHIP_UNIT_POS */
+    uint8_t unitPos = 0;
+
+    /** The parent chip (or the target itself if it is a chip). nullptr if
+     *  there is no parent chip. */
+    pdbg_target* parentChip = nullptr;
+
+    /** The chip ID/EC, chips only. This is zero until it is known to be valid
+     *  (see __getChipIdEc()), which may be after the entry is created. */
+    std::atomic<uint32_t> chipIdEc{0};
+};
+
+// The cached attributes of each target, added as the targets are enumerated by
+// getActiveChips() or on first use. Entries are never removed or replaced, so
+// a reference to an entry remains valid. Access to the map is protected by
+// __targetAttrsMutex.
+std::unordered_map<pdbg_target*, TargetAttributes> __targetAttrs;
+std::shared_mutex __targetAttrsMutex;
+
+/**
+ * @param  i_trgt Given target.
+ * @return The cached attributes of the given target. Only the chip ID/EC may be
+ *         modified after the entry is created.
+ */
+TargetAttributes& __getAttrs(pdbg_target* i_trgt)
+{
+    {
+        std::shared_lock lock{__targetAttrsMutex};
+        auto itr = __targetAttrs.find(i_trgt);
+        if (__targetAttrs.end() != itr)
+        {
+            return itr->second;
+        }
+    }
+
+    if (nullptr == i_trgt)
+    {
+        static TargetAttributes none{};
+        return none;
+    }
+
+    std::unique_lock lock{__targetAttrsMutex};
+
+    auto [itr, added] = __targetAttrs.try_emplace(i_trgt);
+    if (!added)
+    {
+        return itr->second; // added by another thread
+    }
+
+    auto& attrs = itr->second;
+
+    pdbg_target_get_attribute(i_trgt, "ATTR_TYPE", 1, 1, &attrs.type);
+    pdbg_target_get_attribute(i_trgt, "ATTR_FAPI_POS", 4, 1, &attrs.chipPos);
+    pdbg_target_get_attribute(i_trgt, "ATTR_CHIP_UNIT_POS", 1, 1,
+                              &attrs.unitPos);
+
+    if (TYPE_PROC == attrs.type || TYPE_OCMB == attrs.type)
+    {
+        attrs.parentChip = i_trgt;
+    }
+    else
+    {
+        // Check if this unit is on an OCMB. If not, check the PROC.
+        attrs.parentChip = pdbg_target_parent("ocmb", i_trgt);
+        if (nullptr == attrs.parentChip)
+        {
+            attrs.parentChip = pdbg_target_parent("proc", i_trgt);
+        }
+    }
+
+    return attrs;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @param  i_procTrgt A processor target.
+ * @param  i_class    The class of the target (i.e. "pib" or "fsi").
+ * @return The target of the given class associated with the processor.
+ */
+pdbg_target* __getProcTrgt(pdbg_target* i_procTrgt, const char* i_class)
+{
+    char path[16];
+    sprintf(path, "/proc%d/%s", pdbg_target_index(i_procTrgt), i_class);
+    return pdbg_target_from_path(nullptr, path);
+}
+
+/** @return The processor topology read from the device tree. */
+std::vector<ProcTargets> __buildProcTopology()
+{
+    std::vector<ProcTargets> topology;
+
+    pdbg_target* procTrgt;
+    pdbg_for_each_class_target("proc", procTrgt)
+    {
+        ProcTargets entry{};
+
+        entry.proc = procTrgt;
+        entry.pib = __getProcTrgt(procTrgt, "pib");
+        entry.fsi = __getProcTrgt(procTrgt, "fsi");
+        entry.index = pdbg_target_index(procTrgt);
+
+        // We cannot use the proc target to determine if the chip is active.
+        // There is some design limitation in pdbg that requires the proc
+        // targets to always be active. Instead, we must get the associated pib
+        // target and check if it is active. Note that pdbg only probes a target
+        // once, so the result will not change for the life of the process.
+        entry.enabled = (PDBG_TARGET_ENABLED == pdbg_target_probe(procTrgt)) &&
+                        (nullptr != entry.pib) && (nullptr != entry.fsi) &&
+                        (PDBG_TARGET_ENABLED == pdbg_target_probe(entry.pib));
+
+        trace::inf("Processor found: proc=%u pib=%s fsi=%s enabled=%u",
+                   entry.index, (nullptr != entry.pib) ? "yes" : "no",
+                   (nullptr != entry.fsi) ? "yes" : "no", entry.enabled);
+
+        topology.push_back(entry);
+    }
+
+    return topology;
+}
+
+const std::vector<ProcTargets>& getProcTopology()
+{
+    // Built once, the first time it is needed, which must be after the device
+    // tree has been initialized (see pdbg_targets_init()).
+    static const std::vector<ProcTargets> topology = __buildProcTopology();
+    return topology;
+}
+
+const ProcTargets* getProcTargets(pdbg_target* i_procTrgt)
+{
+    for (const auto& entry : getProcTopology())
+    {
+        if (i_procTrgt == entry.proc)
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+const ProcTargets* getProcTargetsByIndex(unsigned int i_procIndex)
+{
+    for (const auto& entry : getProcTopology())
+    {
+        if (i_procIndex == entry.index)
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+
 uint32_t getChipPos(pdbg_target* i_trgt)
 {
-    uint32_t attr = 0;
-    pdbg_target_get_attribute(i_trgt, "ATTR_FAPI_POS", 4, 1, &attr);
-    return attr;
+    return __getAttrs(i_trgt).chipPos;
 }
 
 uint32_t getChipPos(const libhei::Chip& i_chip)
@@ -76,18 +247,14 @@ uint32_t getChipPos(const libhei::Chip& i_chip)
 
 uint8_t getUnitPos(pdbg_target* i_trgt)
 {
-    uint8_t attr = 0;
-    pdbg_target_get_attribute(i_trgt, "ATTR_CHIP_UNIT_POS", 1, 1, &attr);
-    return attr;
+    return __getAttrs(i_trgt).unitPos;
 }
 
 //------------------------------------------------------------------------------
 
 uint8_t getTrgtType(pdbg_target* i_trgt)
 {
-    uint8_t attr = 0;
-    pdbg_target_get_attribute(i_trgt, "ATTR_TYPE", 1, 1, &attr);
-    return attr;
+    return __getAttrs(i_trgt).type;
 }
 
 uint8_t getTrgtType(const libhei::Chip& i_chip)
@@ -101,21 +268,7 @@ pdbg_target* getParentChip(pdbg_target* i_unitTarget)
 {
     assert(nullptr != i_unitTarget);
 
-    // Check if the given target is already a chip.
-    auto targetType = getTrgtType(i_unitTarget);
-    if (TYPE_PROC == targetType || TYPE_OCMB == targetType)
-    {
-        return i_unitTarget; // simply return the given target
-    }
-
-    // Check if this unit is on an OCMB.
-    pdbg_target* parentChip = pdbg_target_parent("ocmb", i_unitTarget);
-
-    // If not on the OCMB, check if this unit is on a PROC.
-    if (nullptr == parentChip)
-    {
-        parentChip = pdbg_target_parent("proc", i_unitTarget);
-    }
+    pdbg_target* parentChip = __getAttrs(i_unitTarget).parentChip;
 
     // There should always be a parent chip. Throw an error if not found.
     if (nullptr == parentChip)
@@ -154,6 +307,53 @@ pdbg_target* getParentProcessor(pdbg_target* i_target)
 
 //------------------------------------------------------------------------------
 
+/** The unit targets of a single unit type within a chip, by unit position. */
+using ChipUnits = std::map<uint8_t, pdbg_target*>;
+
+// The unit targets of each chip, indexed by the parent chip and unit type. The
+// units of a type are indexed the first time any of them is requested (see
+// getChipUnit()). Entries are never removed or replaced, so a reference to an
+// entry remains valid. Access to the map is protected by __chipUnitsMutex.
+std::map<std::pair<pdbg_target*, TargetType_t>, ChipUnits> __chipUnits;
+std::shared_mutex __chipUnitsMutex;
+
+/**
+ * @param  i_parentChip  A chip target.
+ * @param  i_unitType    The unit type.
+ * @param  i_devTreeType The devtree class of the unit type.
+ * @return The unit targets of the given type within the given chip.
+ */
+const ChipUnits& __getChipUnits(pdbg_target* i_parentChip,
+                                TargetType_t i_unitType,
+                                const char* i_devTreeType)
+{
+    auto key = std::make_pair(i_parentChip, i_unitType);
+
+    {
+        std::shared_lock lock{__chipUnitsMutex};
+        auto itr = __chipUnits.find(key);
+        if (__chipUnits.end() != itr)
+        {
+            return itr->second;
+        }
+    }
+
+    // Iterate all children of the parent once and index them by unit position.
+    // Only the first target is kept if there are duplicate positions.
+    ChipUnits units;
+    pdbg_target* unitTarget = nullptr;
+    pdbg_for_each_target(i_devTreeType, i_parentChip, unitTarget)
+    {
+        if (nullptr != unitTarget)
+        {
+            units.emplace(getUnitPos(unitTarget), unitTarget);
+        }
+    }
+
+    std::unique_lock lock{__chipUnitsMutex};
+    return __chipUnits.try_emplace(key, std::move(units)).first->second;
+}
+
 pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
                          uint8_t i_unitPos)
 {
@@ -161,12 +361,12 @@ pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
 
     auto parentType = getTrgtType(i_parentChip);
 
-    std::string devTreeType{};
+    const char* devTreeType = nullptr;
 
     if (TYPE_PROC == parentType)
     {
         // clang-format off
-        static const std::map<TargetType_t, std::string> m =
+        static const std::map<TargetType_t, const char*> m =
         {
             {TYPE_MC,     "mc"      },
             {TYPE_MCC,    "mcc"     },
@@ -190,7 +390,7 @@ pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
     else if (TYPE_OCMB == parentType)
     {
         // clang-format off
-        static const std::map<TargetType_t, std::string> m =
+        static const std::map<TargetType_t, const char*> m =
         {
             {TYPE_MEM_PORT, "mem_port"},
         };
@@ -204,15 +404,11 @@ pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
             "Unexpected parent chip: " + std::string{getPath(i_parentChip)});
     }
 
-    // Iterate all children of the parent and match the unit position.
-    pdbg_target* unitTarget = nullptr;
-    pdbg_for_each_target(devTreeType.c_str(), i_parentChip, unitTarget)
-    {
-        if (nullptr != unitTarget && i_unitPos == getUnitPos(unitTarget))
-        {
-            break; // found it
-        }
-    }
+    // Find the unit position in the index of the parent's units.
+    const auto& units = __getChipUnits(i_parentChip, i_unitType, devTreeType);
+
+    auto itr = units.find(i_unitPos);
+    pdbg_target* unitTarget = (units.end() != itr) ? itr->second : nullptr;
 
     // Print a warning if the target unit is not found, but don't throw an
     // error.  Instead let the calling code deal with the it.
@@ -228,65 +424,66 @@ pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
 
 //------------------------------------------------------------------------------
 
-pdbg_target* getTargetAcrossBus(pdbg_target* i_rxTarget)
+/**
+ * @param  i_machineType The machine type.
+ * @return The path to the peer target file for the given machine type, empty
+ *         if there is no file for the machine type.
+ */
+fs::path __getPeerTargetsPath(util::dbus::MachineType i_machineType)
 {
-    assert(nullptr != i_rxTarget);
-
-    // Validate target type
-    auto rxType = util::pdbg::getTrgtType(i_rxTarget);
-    assert(util::pdbg::TYPE_IOLINK == rxType ||
-           util::pdbg::TYPE_IOHS == rxType);
-
-    pdbg_target* o_peerTarget;
-    fs::path filePath;
-
-    // Open the appropriate data file depending on machine type
-    util::dbus::MachineType machineType = util::dbus::getMachineType();
-    switch (machineType)
+    switch (i_machineType)
     {
         // Rainier/Blue Ridge 4U
         case util::dbus::MachineType::Rainier_2S4U:
         case util::dbus::MachineType::Rainier_1S4U:
         case util::dbus::MachineType::BlueRidge_2S4U:
         case util::dbus::MachineType::BlueRidge_1S4U:
-            filePath =
-                fs::path{PACKAGE_DIR "util-data/peer-targets-rainier-4u.json"};
-            break;
+            return PACKAGE_DIR "util-data/peer-targets-rainier-4u.json";
         // Rainier/Blue Ridge 2U
         case util::dbus::MachineType::Rainier_2S2U:
         case util::dbus::MachineType::Rainier_1S2U:
         case util::dbus::MachineType::BlueRidge_2S2U:
-            filePath =
-                fs::path{PACKAGE_DIR "util-data/peer-targets-rainier-2u.json"};
-            break;
+            return PACKAGE_DIR "util-data/peer-targets-rainier-2u.json";
         // Everest/Fuji
         case util::dbus::MachineType::Everest:
         case util::dbus::MachineType::Fuji:
-            filePath =
-                fs::path{PACKAGE_DIR "util-data/peer-targets-everest.json"};
-            break;
+            return PACKAGE_DIR "util-data/peer-targets-everest.json";
         // Bonnell/Balcones
         case util::dbus::MachineType::Bonnell:
         case util::dbus::MachineType::Balcones:
-            filePath =
-                fs::path{PACKAGE_DIR "util-data/peer-targets-bonnell.json"};
-            break;
+            return PACKAGE_DIR "util-data/peer-targets-bonnell.json";
         default:
             trace::err("Invalid machine type found %d",
-                       static_cast<uint8_t>(machineType));
-            break;
+                       static_cast<uint8_t>(i_machineType));
+            return {};
     }
+}
+
+/** A map of each bus endpoint to the endpoint on the other side of the bus
+ *  (nullptr if not connected). */
+using PeerTargets = std::unordered_map<pdbg_target*, pdbg_target*>;
+
+/**
+ * @param  i_machineType The machine type.
+ * @return The peer targets loaded from the peer target file for the given
+ *         machine type.
+ */
+PeerTargets __loadPeerTargets(util::dbus::MachineType i_machineType)
+{
+    auto filePath = __getPeerTargetsPath(i_machineType);
 
-    std::ifstream file{filePath};
-    assert(file.good());
+    PeerTargets peers;
 
     try
     {
-        auto trgtMap = nlohmann::json::parse(file);
-        std::string rxPath = util::pdbg::getPath(i_rxTarget);
-        std::string peerPath = trgtMap.at(rxPath).get<std::string>();
-
-        o_peerTarget = util::pdbg::getTrgt(peerPath);
+        for (const auto& [rxPath, peerPath] : readPeerTargets(filePath))
+        {
+            auto rxTarget = getTrgt(rxPath);
+            if (nullptr != rxTarget)
+            {
+                peers.emplace(rxTarget, getTrgt(peerPath));
+            }
+        }
     }
     catch (...)
     {
@@ -294,7 +491,56 @@ pdbg_target* getTargetAcrossBus(pdbg_target* i_rxTarget)
         throw;
     }
 
-    return o_peerTarget;
+    return peers;
+}
+
+/** @brief The peer targets and the machine type they were loaded for. */
+struct PeerTargetCache
+{
+    /** The machine type, empty if nothing has been loaded. */
+    std::optional<util::dbus::MachineType> machineType;
+
+    /** The peer targets for the machine type. */
+    PeerTargets peers;
+};
+
+// Access is protected by __peerTargetsMutex.
+PeerTargetCache __peerTargets;
+
+std::mutex __peerTargetsMutex;
+
+pdbg_target* getTargetAcrossBus(pdbg_target* i_rxTarget)
+{
+    assert(nullptr != i_rxTarget);
+
+    // Validate target type
+    auto rxType = util::pdbg::getTrgtType(i_rxTarget);
+    assert(util::pdbg::TYPE_IOLINK == rxType ||
+           util::pdbg::TYPE_IOHS == rxType);
+
+    // The machine type is cached by getMachineType() and is updated from dbus.
+    // So the peer targets are only reloaded if the machine type has changed.
+    // If loading fails, it will be attempted again on the next call.
+    auto machineType = util::dbus::getMachineType();
+
+    std::scoped_lock lock{__peerTargetsMutex};
+
+    if (machineType != __peerTargets.machineType)
+    {
+        __peerTargets.peers = __loadPeerTargets(machineType);
+        __peerTargets.machineType = machineType;
+    }
+
+    const auto& peers = __peerTargets.peers;
+
+    auto itr = peers.find(i_rxTarget);
+    if (peers.end() == itr)
+    {
+        throw std::out_of_range("No peer target entry found: i_rxTarget=" +
+                                std::string{getPath(i_rxTarget)});
+    }
+
+    return itr->second;
 }
 
 //------------------------------------------------------------------------------
@@ -371,17 +617,13 @@ pdbg_target* getConnectedTarget(pdbg_target* i_rxTarget,
 pdbg_target* getPibTrgt(pdbg_target* i_procTrgt)
 {
     // The input target must be a processor.
-    assert(TYPE_PROC == getTrgtType(i_procTrgt));
-
-    // Get the pib path.
-    char path[16];
-    sprintf(path, "/proc%d/pib", pdbg_target_index(i_procTrgt));
+    auto entry = getProcTargets(i_procTrgt);
+    assert(nullptr != entry);
 
     // Return the pib target.
-    pdbg_target* pibTrgt = pdbg_target_from_path(nullptr, path);
-    assert(nullptr != pibTrgt);
+    assert(nullptr != entry->pib);
 
-    return pibTrgt;
+    return entry->pib;
 }
 
 //------------------------------------------------------------------------------
@@ -389,17 +631,13 @@ pdbg_target* getPibTrgt(pdbg_target* i_procTrgt)
 pdbg_target* getFsiTrgt(pdbg_target* i_procTrgt)
 {
     // The input target must be a processor.
-    assert(TYPE_PROC == getTrgtType(i_procTrgt));
-
-    // Get the fsi path.
-    char path[16];
-    sprintf(path, "/proc%d/fsi", pdbg_target_index(i_procTrgt));
+    auto entry = getProcTargets(i_procTrgt);
+    assert(nullptr != entry);
 
     // Return the fsi target.
-    pdbg_target* fsiTrgt = pdbg_target_from_path(nullptr, path);
-    assert(nullptr != fsiTrgt);
+    assert(nullptr != entry->fsi);
 
-    return fsiTrgt;
+    return entry->fsi;
 }
 
 //------------------------------------------------------------------------------
@@ -428,10 +666,19 @@ uint8_t __getChipEc(pdbg_target* i_trgt)
 
 uint32_t __getChipIdEc(pdbg_target* i_trgt)
 {
+    auto& attrs = __getAttrs(i_trgt);
+
+    // The chip ID/EC never changes once it is valid.
+    auto chipIdEc = attrs.chipIdEc.load();
+    if (0 != chipIdEc)
+    {
+        return chipIdEc;
+    }
+
     auto chipId = __getChipId(i_trgt);
     auto chipEc = __getChipEc(i_trgt);
 
-    if (((0 == chipId) || (0 == chipEc)) && (TYPE_PROC == getTrgtType(i_trgt)))
+    if (((0 == chipId) || (0 == chipEc)) && (TYPE_PROC == attrs.type))
     {
         // There is a special case where the model/level attributes have not
         // been initialized in the devtree. This is possible on the epoch
@@ -446,9 +693,21 @@ uint32_t __getChipIdEc(pdbg_target* i_trgt)
             chipId = ((val & 0x0F0FF000) >> 12);
             chipEc = ((val & 0xF0000000) >> 24) | ((val & 0x00F00000) >> 20);
         }
+
+        // Don't cache the value from the CFAM register. The devtree will be
+        // checked again next time.
+        return ((chipId & 0xffff) << 16) | (chipEc & 0xff);
+    }
+
+    chipIdEc = ((chipId & 0xffff) << 16) | (chipEc & 0xff);
+
+    // The devtree attributes are valid, so the value can be cached.
+    if ((0 != chipId) && (0 != chipEc))
+    {
+        attrs.chipIdEc = chipIdEc;
     }
 
-    return ((chipId & 0xffff) << 16) | (chipEc & 0xff);
+    return chipIdEc;
 }
 
 void __addChip(std::vector<libhei::Chip>& o_chips, pdbg_target* i_trgt,
@@ -471,8 +730,17 @@ void __addChip(std::vector<libhei::Chip>& o_chips, pdbg_target* i_trgt,
     }
 }
 
-// Should ignore OCMBs that have been masked on the processor side of the bus.
-bool __isMaskedOcmb(const libhei::Chip& i_chip)
+/**
+ * @brief  Removes the OCMBs that have been masked on the processor side of the
+ *         bus from the given list of chips.
+ *
+ * The DSTL_FIR_MASK of each MCC is shared by the MCC's two memory channels. So
+ * the distinct registers are gathered first and each is read only once.
+ *
+ * @param  io_chips The list of active chips.
+ * @return The number of registers read.
+ */
+size_t __removeMaskedOcmbs(std::vector<libhei::Chip>& io_chips)
 {
     // TODO: This function only works for P10 processors will need to update for
     // subsequent chips.
@@ -483,63 +751,108 @@ bool __isMaskedOcmb(const libhei::Chip& i_chip)
         {4, 0x0E010D03}, {5, 0x0E010D43}, {6, 0x0F010D03}, {7, 0x0F010D43},
     };
 
-    auto ocmb = getTrgt(i_chip);
+    // The DSTL_FIR_MASK values by address, for each processor. A value is
+    // empty if the register has not been read or the read failed.
+    using MaskValues = std::map<uint64_t, std::optional<uint64_t>>;
+    std::map<pdbg_target*, MaskValues> procMasks;
 
-    // Confirm this chip is an OCMB.
-    if (TYPE_OCMB != getTrgtType(ocmb))
-    {
-        return false;
-    }
+    // The processor and DSTL_FIR_MASK address for each OCMB.
+    std::map<pdbg_target*, std::pair<pdbg_target*, uint64_t>> ocmbMasks;
 
-    // Get the connected MCC target on the processor chip.
-    auto mcc = pdbg_target_parent("mcc", ocmb);
-    if (nullptr == mcc)
+    for (const auto& chip : io_chips)
     {
-        throw std::logic_error(
-            "No parent MCC found for " + std::string{getPath(ocmb)});
+        auto ocmb = getTrgt(chip);
+
+        // Confirm this chip is an OCMB.
+        if (TYPE_OCMB != getTrgtType(ocmb))
+        {
+            continue;
+        }
+
+        // Get the connected MCC target on the processor chip.
+        auto mcc = pdbg_target_parent("mcc", ocmb);
+        if (nullptr == mcc)
+        {
+            throw std::logic_error(
+                "No parent MCC found for " + std::string{getPath(ocmb)});
+        }
+
+        auto proc = getParentChip(mcc);
+        auto addr = addrs.at(getUnitPos(mcc));
+
+        procMasks[proc][addr] = std::nullopt;
+        ocmbMasks[ocmb] = {proc, addr};
     }
 
-    // Read the associated DSTL_FIR_MASK.
-    uint64_t val = 0;
-    if (getScom(getParentChip(mcc), addrs.at(getUnitPos(mcc)), val))
+    // The MCCs are reached through the processor's FSI hub and libpdbg is not
+    // thread safe. So the registers are read serially on this thread.
+    size_t reads = 0;
+    for (auto& [proc, masks] : procMasks)
     {
-        // Just let this go. The SCOM code will log the error.
-        return false;
+        for (auto& [addr, value] : masks)
+        {
+            // Just let a failure go. The SCOM code will log the error.
+            uint64_t val = 0;
+            if (0 == getScom(proc, addr, val))
+            {
+                value = val;
+            }
+            reads++;
+        }
     }
 
-    // The DSTL_FIR has bits for each of the two memory channels on the MCC.
-    auto chnlPos = getChipPos(ocmb) % 2;
+    std::erase_if(io_chips, [&](const libhei::Chip& i_chip) {
+        auto ocmb = getTrgt(i_chip);
 
-    // Channel 0 => bits 0-3, channel 1 => bits 4-7.
-    auto mask = (val >> (60 - (4 * chnlPos))) & 0xf;
+        auto itr = ocmbMasks.find(ocmb);
+        if (ocmbMasks.end() == itr)
+        {
+            return false; // not an OCMB
+        }
 
-    // Return true if the mask is set to all 1's.
-    if (0xf == mask)
-    {
-        trace::inf("OCMB masked on processor side of bus: %s", getPath(ocmb));
-        return true;
-    }
+        const auto& [proc, addr] = itr->second;
+        const auto& val = procMasks.at(proc).at(addr);
+        if (!val)
+        {
+            return false; // read failed
+        }
+
+        // The DSTL_FIR has bits for each of the two memory channels on the
+        // MCC.
+        auto chnlPos = getChipPos(ocmb) % 2;
+
+        // Channel 0 => bits 0-3, channel 1 => bits 4-7.
+        auto mask = (*val >> (60 - (4 * chnlPos))) & 0xf;
+
+        // Remove the OCMB if the mask is set to all 1's.
+        if (0xf == mask)
+        {
+            trace::inf("OCMB masked on processor side of bus: %s",
+                       getPath(ocmb));
+            return true;
+        }
+
+        return false; // default
+    });
 
-    return false; // default
+    return reads;
 }
 
 void getActiveChips(std::vector<libhei::Chip>& o_chips)
 {
+    auto start = std::chrono::steady_clock::now();
+
     o_chips.clear();
 
     // Iterate each processor.
-    pdbg_target* procTrgt;
-    pdbg_for_each_class_target("proc", procTrgt)
+    for (const auto& entry : getProcTopology())
     {
-        // We cannot use the proc target to determine if the chip is active.
-        // There is some design limitation in pdbg that requires the proc
-        // targets to always be active. Instead, we must get the associated
-        // pib target and check if it is active.
-
         // Active processors only.
-        if (PDBG_TARGET_ENABLED != pdbg_target_probe(getPibTrgt(procTrgt)))
+        if (!entry.enabled)
             continue;
 
+        pdbg_target* procTrgt = entry.proc;
+
         // Add the processor to the list.
         __addChip(o_chips, procTrgt, __getChipIdEc(procTrgt));
 
@@ -557,9 +870,14 @@ void getActiveChips(std::vector<libhei::Chip>& o_chips)
     }
 
     // Ignore OCMBs that have been masked on the processor side of the bus.
-    o_chips.erase(
-        std::remove_if(o_chips.begin(), o_chips.end(), __isMaskedOcmb),
-        o_chips.end());
+    auto reads = __removeMaskedOcmbs(o_chips);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    trace::inf("Chip enumeration: chips=%zu mask_reads=%zu time=%lldus",
+               o_chips.size(), reads,
+               static_cast<long long>(elapsed.count()));
 }
 
 //------------------------------------------------------------------------------
@@ -568,18 +886,12 @@ void getActiveProcessorChips(std::vector<pdbg_target*>& o_chips)
 {
     o_chips.clear();
 
-    pdbg_target* procTrgt;
-    pdbg_for_each_class_target("proc", procTrgt)
+    for (const auto& entry : getProcTopology())
     {
-        // We cannot use the proc target to determine if the chip is active.
-        // There is some design limitation in pdbg that requires the proc
-        // targets to always be active. Instead, we must get the associated pib
-        // target and check if it is active.
-
-        if (PDBG_TARGET_ENABLED != pdbg_target_probe(getPibTrgt(procTrgt)))
-            continue;
-
-        o_chips.push_back(procTrgt);
+        if (entry.enabled)
+        {
+            o_chips.push_back(entry.proc);
+        }
     }
 }
 
@@ -694,6 +1006,155 @@ std::vector<uint8_t> getPhysBinPath(pdbg_target* target)
 
 //------------------------------------------------------------------------------
 
+// Forward references for the hardware access functions, which are simulated in
+// CI test (see pdbg-no-sim.cpp and pdbg-sim-only.cpp).
+int __getScom(pdbg_target* i_trgt, uint64_t i_addr, uint64_t& o_val);
+int __getCfam(pdbg_target* i_trgt, uint32_t i_addr, uint32_t& o_val);
+
+// The active register cache. Access to the pointer, the cache entries, and the
+// hardware is protected by __registerCacheMutex.
+ScopedRegisterCache* __activeRegisterCache = nullptr;
+std::mutex __registerCacheMutex;
+
+ScopedRegisterCache::ScopedRegisterCache()
+{
+    std::scoped_lock lock{__registerCacheMutex};
+    assert(nullptr == __activeRegisterCache); // only one at a time
+    __activeRegisterCache = this;
+}
+
+ScopedRegisterCache::~ScopedRegisterCache()
+{
+    std::scoped_lock lock{__registerCacheMutex};
+    __activeRegisterCache = nullptr;
+}
+
+void ScopedRegisterCache::invalidate()
+{
+    std::scoped_lock lock{__registerCacheMutex};
+    if (nullptr != __activeRegisterCache)
+    {
+        for (auto& [key, entry] : __activeRegisterCache->iv_entries)
+        {
+            entry.value.reset();
+        }
+    }
+}
+
+void ScopedRegisterCache::invalidate(pdbg_target* i_trgt)
+{
+    std::scoped_lock lock{__registerCacheMutex};
+    if (nullptr != __activeRegisterCache)
+    {
+        for (auto& [key, entry] : __activeRegisterCache->iv_entries)
+        {
+            if (i_trgt == std::get<0>(key))
+            {
+                entry.value.reset();
+            }
+        }
+    }
+}
+
+std::map<ScopedRegisterCache::Key, ScopedRegisterCache::Entry>
+    ScopedRegisterCache::getEntries() const
+{
+    std::scoped_lock lock{__registerCacheMutex};
+    return iv_entries;
+}
+
+void ScopedRegisterCache::traceCounters() const
+{
+    std::scoped_lock lock{__registerCacheMutex};
+
+    size_t hits = 0, misses = 0;
+    for (const auto& [key, entry] : iv_entries)
+    {
+        const auto& [trgt, space, addr] = key;
+
+        trace::inf("Register cache: trgt=%s %s addr=0x%0" PRIx64
+                   " hits=%zu misses=%zu latency=%lld us",
+                   getPath(trgt), (Space::SCOM == space) ? "SCOM" : "CFAM",
+                   addr, entry.hits, entry.misses,
+                   static_cast<long long>(
+                       std::chrono::duration_cast<std::chrono::microseconds>(
+                           entry.latency)
+                           .count()));
+
+        hits += entry.hits;
+        misses += entry.misses;
+    }
+
+    trace::inf("Register cache: registers=%zu hits=%zu misses=%zu",
+               iv_entries.size(), hits, misses);
+}
+
+int ScopedRegisterCache::read(pdbg_target* i_trgt, Space i_space,
+                              uint64_t i_addr, uint64_t& o_val)
+{
+    const Key key{i_trgt, i_space, i_addr};
+
+    auto readHardware = [&](uint64_t& o_hwVal) {
+        if (Space::SCOM == i_space)
+        {
+            return __getScom(i_trgt, i_addr, o_hwVal);
+        }
+
+        uint32_t val = 0;
+        int rc = __getCfam(i_trgt, i_addr, val);
+        o_hwVal = val;
+        return rc;
+    };
+
+    // libpdbg is not thread safe. So the lock is held across the hardware
+    // access, which serializes all register reads.
+    std::scoped_lock lock{__registerCacheMutex};
+    if (nullptr == __activeRegisterCache)
+    {
+        return readHardware(o_val); // nothing to cache
+    }
+
+    auto& entry = __activeRegisterCache->iv_entries[key];
+    if (entry.value)
+    {
+        entry.hits++;
+        o_val = *entry.value;
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int rc = readHardware(o_val);
+    entry.latency += std::chrono::steady_clock::now() - start;
+    entry.misses++;
+    if (0 == rc)
+    {
+        entry.value = o_val;
+    }
+
+    return rc;
+}
+
+//------------------------------------------------------------------------------
+
+int getScom(pdbg_target* i_trgt, uint64_t i_addr, uint64_t& o_val)
+{
+    return ScopedRegisterCache::read(i_trgt, ScopedRegisterCache::Space::SCOM,
+                                     i_addr, o_val);
+}
+
+//------------------------------------------------------------------------------
+
+int getCfam(pdbg_target* i_trgt, uint32_t i_addr, uint32_t& o_val)
+{
+    uint64_t val = 0;
+    int rc = ScopedRegisterCache::read(
+        i_trgt, ScopedRegisterCache::Space::CFAM, i_addr, val);
+    o_val = static_cast<uint32_t>(val);
+    return rc;
+}
+
+//------------------------------------------------------------------------------
+
 } // namespace pdbg
 
 } // namespace util
@@ -4,7 +4,11 @@
 
 #include <analyzer/callout.hpp>
 
+#include <chrono>
+#include <map>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 // Forward reference to avoid pulling the libhei library into everything that
@@ -89,6 +93,40 @@ pdbg_target* getChipUnit(pdbg_target* i_parentChip, TargetType_t i_unitType,
 pdbg_target* getConnectedTarget(pdbg_target* i_rxTarget,
                                 const analyzer::callout::BusType& i_busType);
 
+/** @brief A processor and the targets needed to access it. */
+struct ProcTargets
+{
+    /** The processor target. */
+    pdbg_target* proc = nullptr;
+
+    /** The associated pib target (SCOM access), nullptr if not found. */
+    pdbg_target* pib = nullptr;
+
+    /** The associated fsi target (CFAM access), nullptr if not found. */
+    pdbg_target* fsi = nullptr;
+
+    /** The processor number (see pdbg_target_index()). */
+    unsigned int index = 0;
+
+    /** True, if the pib and fsi targets exist and the processor is enabled. */
+    bool enabled = false;
+};
+
+/**
+ * @return The targets of every processor in the device tree. This is built
+ *         once, on first use, so it must not be called before
+ *         pdbg_targets_init(). The contents never change afterwards.
+ */
+const std::vector<ProcTargets>& getProcTopology();
+
+/** @return The topology entry for the given proc target, nullptr if not
+ *          found. */
+const ProcTargets* getProcTargets(pdbg_target* i_procTrgt);
+
+/** @return The topology entry for the given processor number, nullptr if not
+ *          found. */
+const ProcTargets* getProcTargetsByIndex(unsigned int i_procIndex);
+
 /**
  * @return The pib target associated with the given proc target.
  * @note   Will assert the given target is a proc target.
@@ -104,7 +142,8 @@ pdbg_target* getPibTrgt(pdbg_target* i_procTrgt);
 pdbg_target* getFsiTrgt(pdbg_target* i_procTrgt);
 
 /**
- * @brief  Reads a SCOM register.
+ * @brief  Reads a SCOM register. The result is memoized while a
+ *         ScopedRegisterCache exists.
  * @param  i_trgt Given target.
  * @param  i_addr Given address.
  * @param  o_val  The returned value of the register.
@@ -114,7 +153,8 @@ pdbg_target* getFsiTrgt(pdbg_target* i_procTrgt);
 int getScom(pdbg_target* i_trgt, uint64_t i_addr, uint64_t& o_val);
 
 /**
- * @brief  Reads a CFAM FSI register.
+ * @brief  Reads a CFAM FSI register. The result is memoized while a
+ *         ScopedRegisterCache exists.
  * @param  i_trgt Given target.
  * @param  i_addr Given address.
  * @param  o_val  The returned value of the register.
@@ -123,6 +163,98 @@ int getScom(pdbg_target* i_trgt, uint64_t i_addr, uint64_t& o_val);
  */
 int getCfam(pdbg_target* i_trgt, uint32_t i_addr, uint32_t& o_val);
 
+/**
+ * @brief Memoizes the results of getScom() and getCfam() for each target and
+ *        address while an instance is in scope (i.e. for a single analysis).
+ *
+ * Hardware is only read the first time a register is accessed. Failed reads
+ * are not cached. The hits, misses, and total read latency are counted for each
+ * register and can be traced with traceCounters().
+ *
+ * Only one instance may exist at a time. Anything that writes to hardware
+ * while an instance exists must call invalidate().
+ */
+class ScopedRegisterCache
+{
+  public:
+    /** @brief Constructor. Starts caching. */
+    ScopedRegisterCache();
+
+    /** @brief Destructor. Stops caching. */
+    ~ScopedRegisterCache();
+
+    ScopedRegisterCache(const ScopedRegisterCache&) = delete;
+    ScopedRegisterCache& operator=(const ScopedRegisterCache&) = delete;
+    ScopedRegisterCache(ScopedRegisterCache&&) = delete;
+    ScopedRegisterCache& operator=(ScopedRegisterCache&&) = delete;
+
+    /** The address space of a register. */
+    enum class Space : uint8_t
+    {
+        SCOM,
+        CFAM,
+    };
+
+    /** @brief The cached value and counters for a single register. */
+    struct Entry
+    {
+        /** The register value, if read successfully. */
+        std::optional<uint64_t> value;
+
+        /** The number of reads satisfied from the cache. */
+        size_t hits = 0;
+
+        /** The number of reads from hardware. */
+        size_t misses = 0;
+
+        /** The total time spent reading from hardware. */
+        std::chrono::nanoseconds latency{0};
+    };
+
+    /** The target, address space, and address of a register. */
+    using Key = std::tuple<pdbg_target*, Space, uint64_t>;
+
+    /**
+     * @brief Drops all cached values so that the next read of each register
+     *        goes to hardware. The counters are kept. Does nothing if there is
+     *        no cache in scope.
+     */
+    static void invalidate();
+
+    /**
+     * @brief Same as invalidate() above, except only the registers of the
+     *        given target are dropped.
+     * @param i_trgt Given target.
+     */
+    static void invalidate(pdbg_target* i_trgt);
+
+    /** @return A copy of the entries for all registers accessed so far. */
+    std::map<Key, Entry> getEntries() const;
+
+    /** @brief Traces the counters for each register accessed so far. */
+    void traceCounters() const;
+
+  private:
+    /** The entries for all registers accessed so far. Access is protected by
+     *  the same mutex that protects the active cache (see pdbg.cpp). */
+    std::map<Key, Entry> iv_entries;
+
+    /**
+     * @brief  Reads a register through the active cache, if there is one.
+     *         Otherwise, reads directly from hardware.
+     * @param  i_trgt  Given target.
+     * @param  i_space The address space of the register.
+     * @param  i_addr  Given address.
+     * @param  o_val   The returned value of the register.
+     * @return 0 if successful, non-0 otherwise.
+     */
+    static int read(pdbg_target* i_trgt, Space i_space, uint64_t i_addr,
+                    uint64_t& o_val);
+
+    friend int getScom(pdbg_target*, uint64_t, uint64_t&);
+    friend int getCfam(pdbg_target*, uint32_t, uint32_t&);
+};
+
 /**
  * @brief Returns the list of all active chips in the system.
  * @param o_chips The returned list of chips.
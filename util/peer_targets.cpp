@@ -0,0 +1,117 @@
+#include <nlohmann/json.hpp>
+#include <util/mapped_file.hpp>
+#include <util/peer_targets.hpp>
+#include <util/trace.hpp>
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace util
+{
+
+using namespace peer_targets;
+
+//------------------------------------------------------------------------------
+
+PeerTargetMap parsePeerTargetImage(std::span<const uint8_t> i_data)
+{
+    // The image is generated in little-endian format. There is no support for
+    // converting it on a big-endian host. The caller should fall back to the
+    // JSON data instead.
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        throw std::runtime_error("Peer target image requires little-endian "
+                                 "host");
+    }
+
+    if (i_data.size() < sizeof(Header))
+    {
+        throw std::runtime_error("Peer target image truncated");
+    }
+
+    Header header;
+    memcpy(&header, i_data.data(), sizeof(header));
+
+    if (MAGIC != header.magic)
+    {
+        throw std::runtime_error("Invalid peer target image magic");
+    }
+
+    if (FORMAT_VERSION != header.formatVersion)
+    {
+        throw std::runtime_error("Unsupported peer target image format: " +
+                                 std::to_string(header.formatVersion));
+    }
+
+    size_t entriesSize = sizeof(Entry) * size_t{header.entries};
+    if (i_data.size() - sizeof(Header) < entriesSize + header.stringsSize)
+    {
+        throw std::runtime_error("Peer target image truncated");
+    }
+
+    auto strings = i_data.subspan(sizeof(Header) + entriesSize,
+                                  header.stringsSize);
+
+    // The string table must start with the empty string and end with a NUL
+    // character so that any offset within the table is a valid string.
+    if (strings.empty() || '\0' != strings.front() || '\0' != strings.back())
+    {
+        throw std::runtime_error("Invalid peer target image string table");
+    }
+
+    auto getString = [&](uint32_t i_offset) {
+        if (i_offset >= strings.size())
+        {
+            throw std::runtime_error("Invalid peer target image index");
+        }
+        return std::string{reinterpret_cast<const char*>(&strings[i_offset])};
+    };
+
+    PeerTargetMap map;
+
+    for (size_t i = 0; i < header.entries; i++)
+    {
+        Entry entry;
+        memcpy(&entry, i_data.data() + sizeof(Header) + sizeof(Entry) * i,
+               sizeof(entry));
+
+        map.emplace(getString(entry.rx), getString(entry.peer));
+    }
+
+    return map;
+}
+
+//------------------------------------------------------------------------------
+
+PeerTargetMap readPeerTargets(const std::filesystem::path& i_path)
+{
+    auto imagePath = std::filesystem::path{i_path}.replace_extension(".bin");
+
+    std::error_code ec;
+    if (std::filesystem::exists(imagePath, ec))
+    {
+        try
+        {
+            MappedFile file{imagePath, MappedFile::Access::SEQUENTIAL};
+            return parsePeerTargetImage({file.data(), file.size()});
+        }
+        catch (const std::exception& e)
+        {
+            // Fall back to the JSON file.
+            trace::err("Unable to read peer target image: %s",
+                       imagePath.string().c_str());
+            trace::err(e.what());
+        }
+    }
+
+    MappedFile file{i_path, MappedFile::Access::SEQUENTIAL};
+    auto contents = file.chars();
+    auto json = nlohmann::json::parse(contents.begin(), contents.end());
+
+    return json.get<PeerTargetMap>();
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace util
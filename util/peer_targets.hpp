@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+
+namespace util
+{
+
+/**
+ * @brief Binary peer target image layout.
+ *
+ * The peer target JSON files are compiled into this format at build time by
+ * `peer-targets-compiler.py`. All values are little-endian. Any change to these
+ * structures must bump FORMAT_VERSION here and in the compiler.
+ */
+namespace peer_targets
+{
+
+/** "PEER" */
+constexpr uint32_t MAGIC = 0x50454552;
+
+/** Version of the image layout. */
+constexpr uint16_t FORMAT_VERSION = 1;
+
+/** Image header, followed by the entries and then the string table. */
+struct Header
+{
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t reserved;
+    uint32_t entries;
+    uint32_t stringsSize;
+};
+
+/** Sorted by RX path. */
+struct Entry
+{
+    uint32_t rx;   // string offset
+    uint32_t peer; // string offset, the empty string if not connected
+};
+
+} // namespace peer_targets
+
+/** A map of the devtree path of each bus endpoint to the devtree path of the
+ *  endpoint on the other side of the bus (empty if not connected). */
+using PeerTargetMap = std::map<std::string, std::string>;
+
+/**
+ * @brief  Parses a compiled peer target image.
+ * @param  i_data The contents of the image.
+ * @return The peer target map contained in the image.
+ * @throw  std::runtime_error if the image is not valid.
+ */
+PeerTargetMap parsePeerTargetImage(std::span<const uint8_t> i_data);
+
+/**
+ * @brief  Reads a peer target file. The compiled image next to the given JSON
+ *         file (same name with a `.bin` extension) is preferred, if it exists
+ *         and is valid. Otherwise, the JSON file is parsed.
+ * @param  i_path The path to the peer target JSON file.
+ * @return The peer target map contained in the file.
+ * @throw  std::exception if neither file can be read.
+ */
+PeerTargetMap readPeerTargets(const std::filesystem::path& i_path);
+
+} // namespace util